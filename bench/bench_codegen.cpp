@@ -0,0 +1,78 @@
+// Native code (CodeGen + g++ + dlopen) vs interpreting the same trees (Evaluator::run)
+// Workload : random straight-line programs (Divisors kept non-zero, no runtime error), run many times on the same
+// environment. No constant prelude (every variable is an input the C++ compiler cannot fold away) and every
+// statement accumulate into its target (x = x + <expr>;) so none of them is a dead store
+#include "timer.hpp"
+#include "../tests/random_program.hpp"
+#include "../include/codegen.hpp"
+#include "../include/program.hpp"
+#include <cstdio>
+#include <filesystem>
+
+int main()
+{
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "compy-bench-codegen";
+    std::filesystem::create_directories(dir);
+
+    std::printf("%-12s %-10s %14s %14s %9s %10s\n", "statements", "nodes", "interp ns/run", "native ns/run", "speedup", "build ms");
+    const size_t sizes[] = {10, 100, 1000};  // g++ itself need ~50 s for 10000
+    for (size_t n : sizes)
+    {
+        // A. Program (Start values a ... f set in the environment, not in the source)
+        RandomProgram gen((uint32_t)n, false, true);
+        std::string text;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const std::string target(1, (char)('a' + gen.next(6)));
+            text += target + " = " + target + " + " + gen.expression(4) + ";\n";
+        }
+        std::unique_ptr<Program> program(new Program(text));
+        if (!program->compile())
+        {
+            program->printErrors();
+            return 1;
+        }
+        size_t nodes = 0;
+        for (const auto *stmt : program->statements())
+        {
+            std::vector<const Parser::Node *> stack{stmt};
+            while (!stack.empty())
+            {
+                const Parser::Node *node = stack.back();
+                stack.pop_back();
+                ++nodes;
+                if (node->left)
+                    stack.push_back(node->left);
+                if (node->right)
+                    stack.push_back(node->right);
+            }
+        }
+
+        // B. Build once
+        CodeGen codegen(program->statements());
+        NativeProgram native;
+        const auto buildStart = std::chrono::steady_clock::now();
+        if (!native.build(codegen.emit(), (dir / ("b" + std::to_string(n))).string()))
+        {
+            std::fprintf(stderr, "%s\n", native.getError().c_str());
+            return 1;
+        }
+        const double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+
+        // C. Same number of runs on both (~ 2M nodes evaluated per repeat)
+        const size_t runs = std::max<size_t>(1, 2000000 / nodes);
+        Evaluator env;
+        std::vector<long long> vars(codegen.slotCount(), 0);
+        for (size_t slot = 0; slot < 6; ++slot)
+        {
+            env.set(slot, (long long)slot * 7 + 3);
+            vars[slot] = (long long)slot * 7 + 3;
+        }
+        const double interp = bestNs(5, [&]() { for (size_t r = 0; r < runs; ++r) env.run(program->statements()); keep(env); }) / (double)runs;
+        const double compiled = bestNs(5, [&]() { for (size_t r = 0; r < runs; ++r) native.run(vars.data()); keep(vars); }) / (double)runs;
+
+        std::printf("%-12zu %-10zu %14.0f %14.0f %8.1fx %10.0f\n", n, nodes, interp, compiled, interp / compiled, buildMs);
+    }
+    std::filesystem::remove_all(dir);
+    return 0;
+}
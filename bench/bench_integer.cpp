@@ -0,0 +1,84 @@
+// Exact arithmetic cost : the same 3-operation kernel with wrap around, with raw __builtin_*_overflow checks and
+// with Integer (Fast path only : values stay small), then the interpreter wrapped against exact on one program
+#include "timer.hpp"
+#include "../tests/random_program.hpp"
+#include "../include/exact_evaluator.hpp"
+#include "../include/program.hpp"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// A. Kernel : acc = acc * x + y - z per element (x, y, z small, acc kept small by the data)
+static long long wrap(const std::vector<long long> &v)
+{
+    long long acc = 1;
+    for (size_t i = 0; i + 2 < v.size(); i += 3)
+        acc = compy_arith::sub(compy_arith::add(compy_arith::mul(acc, v[i]), v[i + 1]), v[i + 2]);
+    return acc;
+}
+
+static long long checked(const std::vector<long long> &v, bool &overflow)
+{
+    long long acc = 1;
+    for (size_t i = 0; i + 2 < v.size(); i += 3)
+    {
+        long long m, a;
+        overflow |= __builtin_mul_overflow(acc, v[i], &m);
+        overflow |= __builtin_add_overflow(m, v[i + 1], &a);
+        overflow |= __builtin_sub_overflow(a, v[i + 2], &acc);
+    }
+    return acc;
+}
+
+static Integer exact(const std::vector<Integer> &v)
+{
+    Integer acc(1);
+    for (size_t i = 0; i + 2 < v.size(); i += 3)
+    {
+        Integer::mul(acc, v[i], acc);
+        Integer::add(acc, v[i + 1], acc);
+        Integer::sub(acc, v[i + 2], acc);
+    }
+    return acc;
+}
+
+int main()
+{
+    // x in {-1, 0, 1} keep acc bounded, so no variant leave its fast path
+    const size_t N = 3 * 1000000;
+    std::mt19937 rng(41);
+    std::vector<long long> data(N);
+    std::vector<Integer> boxed(N);
+    for (size_t i = 0; i < N; ++i)
+    {
+        data[i] = (i % 3 == 0) ? (long long)(rng() % 3) - 1 : (long long)(rng() % 1000);
+        boxed[i] = Integer(data[i]);
+    }
+    const size_t elements = N / 3;
+    bool overflow = false;
+    const double tWrap = bestNs(15, [&] { keep(wrap(data)); });
+    const double tChecked = bestNs(15, [&] { keep(checked(data, overflow)); });
+    const double tExact = bestNs(15, [&] { keep(exact(boxed)); });
+    std::printf("kernel acc = acc * x + y - z, %zu elements, best of 15\n", elements);
+    std::printf("  wrap around            %6.2f ns/element\n", tWrap / elements);
+    std::printf("  __builtin_*_overflow   %6.2f ns/element  (%+.0f%%)%s\n", tChecked / elements, 100.0 * (tChecked - tWrap) / tWrap,
+                overflow ? " overflow!" : "");
+    std::printf("  Integer                %6.2f ns/element  (%+.0f%%)\n", tExact / elements, 100.0 * (tExact - tWrap) / tWrap);
+
+    // B. Interpreter on one program (Compile once, run many times : evaluation only). RandomProgram use literals past
+    // 64-bit now and then, so this mix include slow-path operations too
+    const std::string source = RandomProgram(41, false, true).program(20000);
+    Program narrow(source), wide(source);
+    wide.setExact(true);
+    if (!narrow.compile() || !wide.compile())
+    {
+        std::printf("program did not compile\n");
+        return 1;
+    }
+    const double tNarrow = bestNs(9, [&] { Evaluator env; env.run(narrow.statements()); keep(env.get(0)); });
+    const double tWide = bestNs(9, [&] { ExactEvaluator env; env.run(wide.statements()); keep(env.get(0)); });
+    std::printf("interpreter, %zu statements, best of 9\n", narrow.size());
+    std::printf("  Evaluator (wrap)       %6.0f ns/statement\n", tNarrow / narrow.size());
+    std::printf("  ExactEvaluator         %6.0f ns/statement  (%+.0f%%)\n", tWide / wide.size(), 100.0 * (tWide - tNarrow) / tNarrow);
+    return 0;
+}
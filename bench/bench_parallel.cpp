@@ -0,0 +1,103 @@
+// ParallelExecutor against Evaluator::run on generated programs : speedup = sequential time / parallel time
+// (Graph build and commit included), for workloads from fully independent to one dependency chain
+#include "timer.hpp"
+#include "../tests/random_program.hpp"
+#include "../include/parallel_executor.hpp"
+#include "../include/program.hpp"
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Expression of "terms" operands over a ... f (Never assigned by the workloads below : reads only)
+static std::string work(RandomProgram &random, int terms)
+{
+    static const char *ops[] = {" + ", " - ", " * "};
+    std::string text(1, (char)('a' + random.next(6)));
+    for (int t = 1; t < terms; ++t)
+        text += ops[random.next(3)] + std::string(1, (char)('a' + random.next(6)));
+    return text;
+}
+
+static std::string prelude() { return "a = 3;\nb = 5;\nc = 7;\nd = 11;\ne = 13;\nf = 17;\n"; }
+
+// A. Every statement independent (Targets g ... z, reads a ... f)
+static std::string independent(size_t n, int terms)
+{
+    RandomProgram random(36);
+    std::string text = prelude();
+    for (size_t i = 0; i < n; ++i)
+        text += std::string(1, (char)('g' + i % 20)) + " = " + work(random, terms) + ";\n";
+    return text;
+}
+
+// B. Groups of 8 statements : each group reads what the previous group wrote (Critical path n / 8)
+static std::string layered(size_t n, int terms)
+{
+    RandomProgram random(36);
+    std::string text = prelude();
+    for (size_t i = 0; i < n; ++i)
+    {
+        const char target = (char)('g' + (i / 8 % 2) * 8 + i % 8);
+        const char source = (char)('g' + (1 - i / 8 % 2) * 8 + random.next(8));
+        text += std::string(1, target) + " = " + source + " + " + work(random, terms) + ";\n";
+    }
+    return text;
+}
+
+// C. One chain : statement i read statement i - 1 (No parallelism, scheduling cost only)
+static std::string chain(size_t n, int terms)
+{
+    RandomProgram random(36);
+    std::string text = prelude();
+    for (size_t i = 0; i < n; ++i)
+        text += "z = z + " + work(random, terms) + ";\n";
+    return text;
+}
+
+int main()
+{
+    struct Workload
+    {
+        const char *name;
+        std::string (*build)(size_t, int);
+    };
+    const Workload workloads[] = {{"independent", independent}, {"layers of 8", layered}, {"one chain", chain}};
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    const size_t STATEMENTS = 4000;
+    std::vector<unsigned> threadCounts{1, 2, 4};
+    if (cores > 4)
+        threadCounts.push_back(cores);
+
+    std::printf("%zu statements, %u hardware threads, best of 5 runs\n", STATEMENTS, cores);
+    std::printf("%-12s %6s %8s %14s %14s %9s\n", "workload", "terms", "threads", "sequential ms", "parallel ms", "speedup");
+    for (const auto &w : workloads)
+    {
+        for (int terms : {4, 64})
+        {
+            Program program(w.build(STATEMENTS, terms));
+            if (!program.compile())
+            {
+                program.printErrors();
+                return 1;
+            }
+            const double sequentialNs = bestNs(5, [&] {
+                Evaluator env;
+                env.run(program.statements());
+                keep(env.get(25));
+            });
+            for (unsigned threads : threadCounts)
+            {
+                const double parallelNs = bestNs(5, [&] {
+                    Evaluator env;
+                    ParallelExecutor executor(threads);
+                    executor.run(program.statements(), env);
+                    keep(env.get(25));
+                });
+                std::printf("%-12s %6d %8u %14.3f %14.3f %8.2fx\n", w.name, terms, threads, sequentialNs / 1e6, parallelNs / 1e6,
+                            sequentialNs / parallelNs);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+// PersistentEnv : cost of one fork against copying a flat vector of the same variables, and memory per variant
+// (New nodes while 10000 variants of one base are alive) for 1 and 10 writes per variant
+#include "timer.hpp"
+#include "../include/persistent_env.hpp"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+int main()
+{
+    const size_t VARIANTS = 10000;
+    std::printf("%zu variants per base, fork and copy best of 9, %zu bytes per node\n", VARIANTS, PersistentEnv::NODE_BYTES);
+    std::printf("  %9s  %10s  %12s  %14s  %14s  %12s\n", "variables", "fork", "vector copy", "1 write", "10 writes", "full copy");
+    for (size_t variables : {(size_t)26, (size_t)10000, (size_t)1000000})
+    {
+        PersistentEnv base;
+        std::vector<long long> flat(variables);
+        for (size_t slot = 0; slot < variables; ++slot)
+        {
+            base.set(slot, (long long)slot);
+            flat[slot] = (long long)slot;
+        }
+
+        // A. Fork against a deep copy, both into a slot that already hold one from the previous round (Fork = one count
+        // up + one down; copy reuse the vector capacity, so it is a memcpy without allocation : lower bound of a copy)
+        std::vector<PersistentEnv> forks(VARIANTS);
+        const double tFork = bestNs(9, [&] {
+            for (size_t k = 0; k < VARIANTS; ++k)
+                forks[k] = base.fork();
+        });
+        forks.assign(VARIANTS, PersistentEnv());
+        const size_t copies = variables >= 1000000 ? 20 : VARIANTS;    // 10000 copies of 8 MB do not fit in memory
+        std::vector<std::vector<long long>> copied(copies);
+        const double tCopy = bestNs(9, [&] {
+            for (size_t k = 0; k < copies; ++k)
+                copied[k] = flat;
+        });
+        copied.clear();
+        copied.shrink_to_fit();
+
+        // B. Memory : new nodes while every variant is alive, written at random slots
+        double perVariant[2];
+        const int writes[] = {1, 10};
+        for (int w = 0; w < 2; ++w)
+        {
+            std::mt19937 rng(42);
+            const size_t before = PersistentEnv::liveNodes();
+            for (size_t k = 0; k < VARIANTS; ++k)
+            {
+                forks[k] = base.fork();
+                for (int i = 0; i < writes[w]; ++i)
+                    forks[k].set(rng() % variables, -1);
+            }
+            perVariant[w] = (double)(PersistentEnv::liveNodes() - before) * PersistentEnv::NODE_BYTES / VARIANTS;
+            forks.assign(VARIANTS, PersistentEnv());
+        }
+
+        char fork[32], copy[32], one[32], ten[32];
+        std::snprintf(fork, sizeof(fork), "%.1f ns", tFork / VARIANTS);
+        std::snprintf(copy, sizeof(copy), "%.0f ns", tCopy / copies);
+        std::snprintf(one, sizeof(one), "%.0f B", perVariant[0]);
+        std::snprintf(ten, sizeof(ten), "%.0f B", perVariant[1]);
+        std::printf("  %9zu  %10s  %12s  %14s  %14s  %10zu B\n", variables, fork, copy, one, ten, variables * sizeof(long long));
+    }
+    return 0;
+}
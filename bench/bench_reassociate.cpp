@@ -0,0 +1,52 @@
+// Reassociation : height of one long + / - or '*' chain before and after the pass, cost of the pass (Compile with and
+// without --balance) and evaluation time of the left-deep against the balanced tree
+#include "timer.hpp"
+#include "../include/evaluator.hpp"
+#include "../include/program.hpp"
+#include <cstdio>
+#include <random>
+#include <string>
+
+static std::string chain(size_t terms, bool product)
+{
+    std::mt19937 rng(43);
+    std::string text = "a = 3;\nb = -7;\nc = 11;\nd = 2;\ne = -1;\nf = 5;\nx = a";
+    for (size_t i = 1; i < terms; ++i)
+    {
+        text += product ? " * " : (rng() & 1) ? " - " : " + ";
+        text += (char)('a' + rng() % 6);
+    }
+    return text + ";\n";
+}
+
+int main()
+{
+    std::printf("one chain of N terms, best of 9\n");
+    std::printf("  %-4s %7s  %15s  %21s  %25s\n", "op", "N", "height", "compile (ms)", "evaluate (ns/term)");
+    for (bool product : {false, true})
+    {
+        for (size_t terms : {(size_t)1000, (size_t)10000, (size_t)100000})
+        {
+            const std::string source = chain(terms, product);
+            Program plain(source), balanced(source);
+            balanced.setBalance(true);
+            if (!plain.compile() || !balanced.compile())
+            {
+                std::printf("chain did not compile\n");
+                return 1;
+            }
+
+            const double tPlainCompile = bestNs(9, [&] { Program p(source); keep(p.compile()); });
+            const double tBalancedCompile = bestNs(9, [&] { Program p(source); p.setBalance(true); keep(p.compile()); });
+            const double tPlain = bestNs(9, [&] { Evaluator env; env.run(plain.statements()); keep(env.get(23)); });
+            const double tBalanced = bestNs(9, [&] { Evaluator env; env.run(balanced.statements()); keep(env.get(23)); });
+
+            char height[32], compile[48], evaluate[48];
+            std::snprintf(height, sizeof(height), "%zu -> %zu", balanced.reassociation().heightBefore(), balanced.reassociation().heightAfter());
+            std::snprintf(compile, sizeof(compile), "%.2f -> %.2f", tPlainCompile / 1e6, tBalancedCompile / 1e6);
+            std::snprintf(evaluate, sizeof(evaluate), "%.2f -> %.2f (x%.2f)", tPlain / terms, tBalanced / terms, tPlain / tBalanced);
+            std::printf("  %-4s %7zu  %15s  %21s  %25s\n", product ? "*" : "+ -", terms, height, compile, evaluate);
+        }
+    }
+    return 0;
+}
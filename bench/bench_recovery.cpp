@@ -0,0 +1,67 @@
+// Parser error recovery on adversarial input : parse time per token must stay flat as the input grows,
+// however many errors it holds (Lexing is done once, outside the timing)
+#include "timer.hpp"
+#include "../include/lexer.hpp"
+#include "../include/parser.hpp"
+#include <cstdio>
+#include <random>
+#include <string>
+
+struct Pattern
+{
+    const char *name;
+    const char *unit;       // Repeated inside one statement "x = ... ;" (nullptr = random soup)
+};
+
+static std::string build(const Pattern &p, size_t repeats)
+{
+    std::string text = "x = ";
+    if (p.unit)
+    {
+        for (size_t i = 0; i < repeats; ++i)
+            text += p.unit;
+    }
+    else
+    {
+        // Random Token soup (Every kind of Token, nesting stay shallow on average)
+        static const char *pieces[] = {"a ", "7 ", "+ ", "- ", "* ", "/ ", "% ", "^ ", "= ", "( ", ") ", "; ", "$ ", "b "};
+        std::mt19937 rng(42);
+        for (size_t i = 0; i < repeats * 4; ++i)
+            text += pieces[rng() % (sizeof(pieces) / sizeof(pieces[0]))];
+    }
+    return text + ";";
+}
+
+int main()
+{
+    const Pattern patterns[] = {
+        {"valid chain", "a + 1 * "},
+        {"operator soup", "+ * / ^ = "},
+        {"missing operator", "a b 1 2 "},
+        {"stray parens", "( a ) ) + "},
+        {"empty parens", "() () + "},
+        {"invalid chars", "$ # a @ "},
+        {"statement spam", "= ; x "},
+        {"random soup", nullptr},
+    };
+
+    std::printf("%-18s %10s %12s %12s %14s\n", "pattern", "tokens", "parse ms", "ns/token", "diagnostics");
+    for (const Pattern &p : patterns)
+    {
+        for (size_t repeats : {1000, 10000, 100000, 1000000})
+        {
+            const std::string text = build(p, repeats);
+            Lexer lexer(text);
+            const std::vector<Token> tokens = lexer.tokenize();
+            size_t diagnostics = 0;
+            const double ns = bestNs(3, [&]()
+            {
+                Parser parser(tokens);
+                parser.parse();
+                diagnostics = parser.getErrors().size();
+            });
+            std::printf("%-18s %10zu %12.2f %12.1f %14zu\n", p.name, tokens.size(), ns / 1e6, ns / (double)tokens.size(), diagnostics);
+        }
+    }
+    return 0;
+}
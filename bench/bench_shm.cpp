@@ -0,0 +1,119 @@
+// Shared-memory ingestion against stdin piping : messages/s of main --check fed by a pipe, of main --shm-client with
+// 1 and 2 producer processes (Process start included on both sides), and round-trip latency with one statement in flight
+#include "../tests/random_program.hpp"
+#include "../include/shm_ring.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+static double wallMs(const std::string &command)
+{
+    const auto start = std::chrono::steady_clock::now();
+    if (std::system(command.c_str()) != 0)
+        std::printf("  (command failed : %s)\n", command.c_str());
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    const char *mainPath = std::getenv("COMPY_MAIN");
+    if (!mainPath)
+    {
+        std::printf("COMPY_MAIN not set (run through bench/run_bench.sh)\n");
+        return 1;
+    }
+    const std::string main = mainPath;
+    const std::string name = "compy-bench-" + std::to_string(::getpid());
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / name;
+    std::filesystem::create_directories(dir);
+
+    // A. Input : statements that fit a slot
+    const size_t COUNT = 200000;
+    std::vector<std::string> statements;
+    RandomProgram random(44);
+    while (statements.size() < COUNT)
+    {
+        std::string text = random.statement(3);
+        if (text.size() <= ShmRing::SLOT_BYTES)
+            statements.push_back(text);
+    }
+    const std::string in = (dir / "in.txt").string();
+    {
+        std::ofstream file(in);
+        for (const std::string &text : statements)
+            file << text << "\n";
+    }
+
+    // B. Throughput : pipe into --check, then 1 and 2 clients on a 1-thread server (Best of 3)
+    double pipeMs = 0, oneMs = 0, twoMs = 0;
+    for (int round = 0; round < 3; ++round)
+    {
+        const double ms = wallMs("cat " + in + " | " + main + " --check > /dev/null");
+        pipeMs = round ? std::min(pipeMs, ms) : ms;
+    }
+
+    std::thread server([&] { std::system((main + " --shm " + name + " 1 2> /dev/null").c_str()); });
+    bool ready = false;
+    for (int attempt = 0; attempt < 250 && !ready; ++attempt)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ShmRing probe;
+        ready = probe.open(name);
+    }
+    if (!ready)
+    {
+        std::printf("server did not start\n");
+        server.detach();
+        return 1;
+    }
+    const std::string client = main + " --shm-client " + name + " < " + in + " > /dev/null";
+    for (int round = 0; round < 3; ++round)
+    {
+        const double one = wallMs(client);
+        const double two = wallMs("(" + client + " & " + client + "; wait)");
+        oneMs = round ? std::min(oneMs, one) : one;
+        twoMs = round ? std::min(twoMs, two) : two;
+    }
+
+    // C. Latency : submit one statement, wait for its verdict (Producer in this process, server in its own)
+    std::vector<double> latency;
+    {
+        ShmRing ring;
+        if (!ring.open(name))
+        {
+            std::printf("%s\n", ring.getError().c_str());
+            return 1;
+        }
+        ShmRing::Response response;
+        for (size_t i = 0; i < 20000; ++i)
+        {
+            const std::string &text = statements[i];
+            const auto start = std::chrono::steady_clock::now();
+            while (!ring.submit(i, text.data(), text.size()))
+                std::this_thread::yield();
+            for (unsigned idle = 0; !ring.collect(response);)
+                ShmRing::backoff(idle);
+            latency.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        }
+        while (!ring.submit(0, "exit", 4))
+            std::this_thread::yield();
+    }
+    server.join();
+    std::filesystem::remove_all(dir);
+    std::sort(latency.begin(), latency.end());
+
+    std::printf("%zu statements, 1 server thread, best of 3 (process start included)\n", COUNT);
+    std::printf("  stdin pipe into --check       %6.2f M msg/s\n", COUNT / pipeMs / 1000.0);
+    std::printf("  --shm-client, 1 producer      %6.2f M msg/s\n", COUNT / oneMs / 1000.0);
+    std::printf("  --shm-client, 2 producers     %6.2f M msg/s\n", 2 * COUNT / twoMs / 1000.0);
+    std::printf("round trip, one statement in flight, %zu samples : p50 %.1f us, p99 %.1f us\n", latency.size(),
+                latency[latency.size() / 2], latency[latency.size() * 99 / 100]);
+    std::printf("  (--check does not flush per line, so a pipe has no one-in-flight figure to compare)\n");
+    return 0;
+}
@@ -0,0 +1,71 @@
+// Tracing overhead : lex + parse + range analysis of every statement, as the interactive loop does it,
+// with tracing off, on for 1 statement in 100 (Production setting) and on for every statement
+#include "timer.hpp"
+#include "../tests/random_program.hpp"
+#include "../include/lexer.hpp"
+#include "../include/range_analysis.hpp"
+#include "../include/trace.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static size_t compileRange(const std::vector<std::string> &statements, size_t begin, size_t end)
+{
+    size_t nodes = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+        const std::string &text = statements[i];
+        Trace::beginStatement();
+        Lexer lexer(text);
+        const std::vector<Token> tokens = lexer.tokenize();
+        Parser parser(tokens);
+        if (parser.parse())
+        {
+            RangeAnalysis ranges;
+            ranges.analyze(parser.getRoot());
+            nodes += ranges.checkCount();
+        }
+    }
+    return nodes;
+}
+
+int main()
+{
+    std::vector<std::string> statements;
+    RandomProgram random(34);
+    for (int i = 0; i < 20000; ++i)
+        statements.push_back(random.statement(5));
+
+    // Chunks of 1000 statements, configurations interleaved round by round (Same machine state for the three) :
+    // best round of each chunk kept, then summed (A noisy moment only spoil one chunk of one round)
+    const size_t CHUNK = 1000;
+    const int ROUNDS = 21;
+    const unsigned sample[] = {0, 100, 1};
+    const char *label[] = {"off", "on, 1 in 100", "on, every statement"};
+    double total[3] = {0, 0, 0};
+    for (size_t begin = 0; begin < statements.size(); begin += CHUNK)
+    {
+        double best[3] = {0, 0, 0};
+        for (int round = 0; round < ROUNDS; ++round)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                if (sample[k])
+                    Trace::enable(sample[k]);
+                else
+                    Trace::disable();
+                const double ns = bestNs(1, [&] { keep(compileRange(statements, begin, begin + CHUNK)); });
+                best[k] = round ? std::min(best[k], ns) : ns;
+            }
+        }
+        for (int k = 0; k < 3; ++k)
+            total[k] += best[k];
+    }
+    Trace::disable();
+
+    std::printf("%zu statements, lex + parse + analyze, best of %d rounds per %zu statements\n", statements.size(), ROUNDS, CHUNK);
+    for (int k = 0; k < 3; ++k)
+        std::printf("  tracing %-20s %9.0f ns/statement  overhead %+5.2f%%\n", label[k], total[k] / statements.size(),
+                    100.0 * (total[k] - total[0]) / total[0]);
+    return 0;
+}
@@ -0,0 +1,35 @@
+#!/bin/sh
+# Build every bench/bench_*.cpp against src/ (main.cpp left out, -O2) and run it; main is built too for the
+# benchmarks that drive the command line (path given in COMPY_MAIN). Numbers go to stdout.
+#   bench/run_bench.sh            all benchmarks
+#   bench/run_bench.sh codegen    bench/bench_codegen.cpp only
+cd "$(dirname "$0")/.." || exit 1
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:--O2 -DNDEBUG}
+OUT=${OUT:-build/bench}
+FLAGS="-std=c++17 -pthread -Iinclude $CXXFLAGS"
+mkdir -p "$OUT/obj" && OUT=$(cd "$OUT" && pwd) || exit 1     # Absolute from here on (OUT may be given relative or absolute)
+
+# A. Library objects (Rebuilt when the source or any header is newer)
+OBJS=""
+for src in src/*.cpp; do
+    obj="$OUT/obj/$(basename "$src" .cpp).o"
+    if [ ! -f "$obj" ] || [ -n "$(find "$src" include -newer "$obj" 2>/dev/null | head -n 1)" ]; then
+        $CXX $FLAGS -c "$src" -o "$obj" || exit 1
+    fi
+    [ "$src" = "src/main.cpp" ] || OBJS="$OBJS $obj"
+done
+$CXX $FLAGS "$OUT/obj/main.o" $OBJS -o "$OUT/main" -ldl || exit 1
+COMPY_MAIN="$OUT/main"
+export COMPY_MAIN
+
+# B. Benchmarks
+for bench in bench/bench_*.cpp; do
+    name=$(basename "$bench" .cpp)
+    if [ $# -gt 0 ] && [ "bench_$1" != "$name" ]; then
+        continue
+    fi
+    $CXX $FLAGS "$bench" $OBJS -o "$OUT/$name" -ldl || exit 1
+    echo "== $name"
+    "$OUT/$name" || exit 1
+done
@@ -0,0 +1,23 @@
+#pragma once                // Header Guard
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+// Best of several timed runs in nanoseconds (Least disturbed by the rest of the machine)
+template <typename Fn>
+double bestNs(int repeats, Fn &&fn)
+{
+    double best = 0.0;
+    for (int i = 0; i < repeats; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = i ? std::min(best, ns) : ns;
+    }
+    return best;
+}
+
+// Keep a value alive so the optimizer cannot drop the work that made it
+template <typename T>
+inline void keep(const T &value) { asm volatile("" : : "g"(&value) : "memory"); }
@@ -0,0 +1,52 @@
+#pragma once                // Header Guard
+#include <cstddef>
+
+// Allocation Instrumentation (Opt-in build : g++ -DCOMPY_ALLOC_TRACE -rdynamic src/*.cpp -Iinclude -o main.exe -ldl)
+// Replace global operator new / delete to count allocation, byte and peak live memory
+// per phase (AllocPhase scope) and per statement, plus the top allocation sites (First COMPY
+// frame above operator new; -rdynamic let dladdr name it).
+// Without the flag every call below compile to nothing.
+
+#ifdef COMPY_ALLOC_TRACE
+
+// AllocPhase Class : Allocation made while alive are charged to the named phase (Per thread, nestable)
+class AllocPhase
+{
+public:
+    explicit AllocPhase(const char *name);      // Enter phase (name must be a string literal)
+    ~AllocPhase();                              // Back to previous phase
+    AllocPhase(const AllocPhase &) = delete;
+    AllocPhase &operator=(const AllocPhase &) = delete;
+
+private:
+    int previous;                               // Phase active before this scope
+};
+
+// AllocTrace Class : Statement boundary + report
+class AllocTrace
+{
+public:
+    static const bool enabled = true;
+    static void beginStatement();               // Reset per-statement counter (Live memory is kept)
+    static size_t allocations();                // Allocation since beginStatement (For "zero allocation" budget)
+    static void report(size_t topSites = 5);    // Print per-phase table + top allocation sites
+};
+
+#else
+
+class AllocPhase
+{
+public:
+    explicit AllocPhase(const char *) {}
+};
+
+class AllocTrace
+{
+public:
+    static const bool enabled = false;
+    static void beginStatement() {}
+    static size_t allocations() { return 0; }
+    static void report(size_t = 5) {}
+};
+
+#endif
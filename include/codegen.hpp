@@ -0,0 +1,63 @@
+#pragma once                // Header Guard
+#include "parser.hpp"       // Include Node Definition
+#include "evaluator.hpp"    // Include Variable Slot + Arithmetic
+#include <string>
+#include <vector>
+
+// Variables of a single letter program (a ... z). Extended names need CodeGen::slotCount() values instead
+struct CompyVars
+{
+    long long v[Evaluator::VARIABLE_COUNT];
+};
+
+// Fixed entry point of generated code (vars = flat array index by symbol id)
+// Return 0 when successful, n when statement n (1-based) divide by zero
+typedef int (*CompyEntry)(long long *vars);
+
+// CodeGen Class walks statement trees and emits a self-contained C++ translation unit (Ahead-of-time)
+class CodeGen
+{
+
+// Public Member
+public:
+    explicit CodeGen(const std::vector<const Parser::Node *> &stmts);  // Constructor
+    std::string emit();                                                 // Return generated C++ source
+    size_t slotCount() const { return slots; }                          // Variable array size the emitted code use
+
+// Private Member
+private:
+    const std::vector<const Parser::Node *> &statements;   // Trees to translate (in order)
+    std::string body;                                       // Body of compy_run being generated
+    int tempCount;                                          // Next temporary number (t0, t1, ...)
+    size_t slots;                                           // Highest symbol id used + 1 (at least a ... z)
+
+    std::string emitExpr(const Parser::Node *root, size_t stmtNo);     // Emit code for expression (Iterative), return C++ operand
+};
+
+// NativeProgram Class compiles generated source with local g++ and loads it as shared object
+class NativeProgram
+{
+
+// Public Member
+public:
+    NativeProgram();                                                    // Constructor (nothing loaded)
+    ~NativeProgram();                                                   // Unload shared object
+    NativeProgram(const NativeProgram &) = delete;
+    NativeProgram &operator=(const NativeProgram &) = delete;
+
+    bool build(const std::string &source, const std::string &basePath); // Write basePath.cpp, compile, load : true when ready
+    int run(CompyVars &vars) const { return entry(vars.v); }            // Call compy_run
+    int run(long long *vars) const { return entry(vars); }              // Same, array of at least slotCount() values
+
+    bool isLoaded() const { return entry != nullptr; }
+    const std::string &getError() const { return error; }               // Reason of last failed build
+
+// Private Member
+private:
+    void *handle;           // dlopen / LoadLibrary handle
+    CompyEntry entry;       // Address of compy_run
+    std::string error;      // Last build error
+
+    void unload();
+    bool compile(const std::string &sourcePath, const std::string &libPath);   // Run g++ (argv array, no shell)
+};
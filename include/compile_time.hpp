@@ -0,0 +1,305 @@
+#pragma once                // Header Guard
+#include "token.hpp"        // Include Token Type
+#include "evaluator.hpp"    // Include Arithmetic (constexpr)
+#include <cstddef>
+
+// Compile-time COMPY : constexpr Lexer + Parser for fixed formulas written as string literal
+//
+//   constexpr auto f = compy_ct::compile("x = (a + 2) * b;");   // Parsed by the compiler
+//   long long vars[26] = {};  f(vars);                          // Only evaluation at runtime
+//
+// Same grammar and rules as Lexer::tokenize / Parser::parse [ <stmt> -> id = <expr> ; ], same operator
+// precedence table (+ - < * / % < ^ right associative, unary '-' bind looser than '^').
+// The first lexical / syntax error Parser would report becomes a compile error (the message
+// is shown in the "constexpr expansion of fail(...)" note). Must live in header (constexpr).
+namespace compy_ct
+{
+    // Raise compile error when reached during constant evaluation (runtime : throws const char *)
+    constexpr void fail(const char *msg)
+    {
+        if (msg)
+            throw msg;
+    }
+
+    // One Token (Value kept as number / slot, no string at compile time)
+    struct Token
+    {
+        TokenType type = TokenType::INVALID;
+        char op = 0;                // Operator character
+        long long value = 0;        // NUMBER value (wrap around, same as compy_arith::parseLiteral)
+        bool zero = false;          // Literal is exactly "0" (Parser division by zero rule)
+        size_t slot = 0;            // IDENTIFIER variable slot
+    };
+
+    // One tree Node (Children are index into Formula::nodes, -1 when none : unary '-' has only right)
+    struct Node
+    {
+        TokenType type = TokenType::INVALID;
+        char op = 0;
+        long long value = 0;
+        bool zero = false;
+        size_t slot = 0;
+        int left = -1;
+        int right = -1;
+    };
+
+    // Parsed formula (N = literal length : never more Token / Node than characters)
+    template <size_t N>
+    struct Formula
+    {
+        Node nodes[N] = {};
+        int count = 0;
+        int expr = -1;              // Root of right-hand expression
+        size_t target = 0;          // Slot of assigned variable
+
+        // Evaluate Node (Post-order) : false when dividing by zero
+        constexpr bool evaluate(int i, const long long *vars, long long &out) const
+        {
+            const Node &n = nodes[i];
+            if (n.type == TokenType::OPERATOR && n.left < 0)
+            {
+                long long r = 0;
+                if (!evaluate(n.right, vars, r))
+                    return false;
+                out = compy_arith::sub(0, r);
+                return true;
+            }
+            if (n.type == TokenType::NUMBER)
+            {
+                out = n.value;
+                return true;
+            }
+            if (n.type == TokenType::IDENTIFIER)
+            {
+                out = vars[n.slot];
+                return true;
+            }
+
+            long long l = 0, r = 0;
+            if (!evaluate(n.left, vars, l) || !evaluate(n.right, vars, r))
+                return false;
+            switch (n.op)
+            {
+            case '+': out = compy_arith::add(l, r); return true;
+            case '-': out = compy_arith::sub(l, r); return true;
+            case '*': out = compy_arith::mul(l, r); return true;
+            case '%': return compy_arith::mod(l, r, out);
+            case '^': return compy_arith::pow(l, r, out);
+            default:  return compy_arith::div(l, r, out);
+            }
+        }
+
+        // Run the assignment on a variable array : false when dividing by zero (variable unchanged)
+        constexpr bool operator()(long long *vars) const
+        {
+            long long v = 0;
+            if (!evaluate(expr, vars, v))
+                return false;
+            vars[target] = v;
+            return true;
+        }
+    };
+
+    // Recursive descent Parser (No recovery : first error is fatal, same order as Parser)
+    template <size_t N>
+    class Parser
+    {
+    public:
+        constexpr explicit Parser(const char (&src)[N]) : text(src) {}
+
+        constexpr Formula<N> run()
+        {
+            tokenize();
+            if (tokenCount == 0)
+                fail("Empty input.");
+
+            // A. [ id = ]
+            if (tokens[0].type != TokenType::IDENTIFIER)
+                fail("statement must start with an identifier");
+            out.target = tokens[0].slot;
+            pos = 1;
+
+            if (pos >= tokenCount || tokens[pos].type != TokenType::ASSIGNMENT)
+                fail("missing '=' after identifier");
+            if (pos + 1 < tokenCount && tokens[pos + 1].type == TokenType::ASSIGNMENT)
+                fail("extra assignment '==' is not allowed.");
+            ++pos;
+
+            if (pos >= tokenCount || tokens[pos].type == TokenType::STATEMENT_TERMINATOR)
+                fail("missing right-hand expression after '='.");
+
+            // B. <expr> ;
+            out.expr = parseExpr();
+            if (pos >= tokenCount || tokens[pos].type != TokenType::STATEMENT_TERMINATOR)
+                fail("missing statement terminator ';'.");
+            if (pos + 1 < tokenCount)
+                fail("more expressions found after ';' (only one statement allowed).");
+            return out;
+        }
+
+    private:
+        const char (&text)[N];
+        Token tokens[N] = {};
+        size_t tokenCount = 0;
+        size_t pos = 0;
+        Formula<N> out = {};
+
+        static constexpr bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f'; }
+        static constexpr bool isLower(char c) { return c >= 'a' && c <= 'z'; }
+        static constexpr bool isAlpha(char c) { return isLower(c) || (c >= 'A' && c <= 'Z'); }
+        static constexpr bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+        // Lexer rules (Literal end with '\0', not part of the source)
+        constexpr void tokenize()
+        {
+            size_t i = 0;
+            while (i + 1 < N)
+            {
+                const char c = text[i];
+                Token t;
+                if (isSpace(c))
+                {
+                    ++i;
+                    continue;
+                }
+                if (isAlpha(c))
+                {
+                    const size_t start = i;
+                    while (i + 1 < N && isAlpha(text[i]))
+                        ++i;
+                    if (i - start != 1 || !isLower(c))
+                        fail("LexicalError: invalid character (identifier is a single lowercase letter)");
+                    t.type = TokenType::IDENTIFIER;
+                    t.slot = (size_t)(c - 'a');
+                }
+                else if (isDigit(c))
+                {
+                    const size_t start = i;
+                    unsigned long long v = 0;
+                    while (i + 1 < N && isDigit(text[i]))
+                        v = v * 10 + (unsigned long long)(text[i++] - '0');
+                    t.type = TokenType::NUMBER;
+                    t.value = (long long)v;
+                    t.zero = (i - start == 1 && c == '0');
+                }
+                else
+                {
+                    switch (c)
+                    {
+                    case '+': case '-': case '*': case '/': case '%': case '^': t.type = TokenType::OPERATOR; t.op = c; break;
+                    case '=': t.type = TokenType::ASSIGNMENT; break;
+                    case '(': t.type = TokenType::LEFT_PAREN; break;
+                    case ')': t.type = TokenType::RIGHT_PAREN; break;
+                    case ';': t.type = TokenType::STATEMENT_TERMINATOR; break;
+                    default: fail("LexicalError: invalid character");
+                    }
+                    ++i;
+                }
+                tokens[tokenCount++] = t;
+            }
+        }
+
+        constexpr bool at(TokenType type) const { return pos < tokenCount && tokens[pos].type == type; }
+
+        // Operator table (Same as Parser)
+        static constexpr int precedence(char op) { return (op == '+' || op == '-') ? 1 : (op == '^') ? 3 : 2; }
+
+        constexpr int newNode(const Node &n)
+        {
+            out.nodes[out.count] = n;
+            return out.count++;
+        }
+
+        constexpr int newOperator(char op, int left, int right)
+        {
+            Node n;
+            n.type = TokenType::OPERATOR;
+            n.op = op;
+            n.left = left;
+            n.right = right;
+            return newNode(n);
+        }
+
+        // [ <expr> -> <binary(1)> ]
+        constexpr int parseExpr() { return parseBinary(1); }
+
+        // Precedence climbing [ <binary(p)> -> <factor> { op <binary(q)> } ] (q = p for '^', else precedence + 1)
+        constexpr int parseBinary(int minPrecedence)
+        {
+            int left = parseFactor();
+            if (left < 0)
+                return left;
+            while (at(TokenType::OPERATOR) && precedence(tokens[pos].op) >= minPrecedence)
+            {
+                const char op = tokens[pos++].op;
+                const int right = parseBinary(op == '^' ? precedence(op) : precedence(op) + 1);
+                if ((op == '/' || op == '%') && out.nodes[right].type == TokenType::NUMBER && out.nodes[right].zero)
+                    fail("division by zero is not allowed.");
+                left = newOperator(op, left, right);
+            }
+
+            // Parser FOLLOW(<term>) check (Operand of '*' '/' '%' '^' leave it to the enclosing level)
+            if (minPrecedence > 2)
+                return left;
+            if (at(TokenType::ASSIGNMENT))
+                fail("chained assignment is not allowed (found '=' in expression).");
+            if (at(TokenType::IDENTIFIER) || at(TokenType::NUMBER) || at(TokenType::LEFT_PAREN))
+                fail("missing operator before operand");
+            return left;
+        }
+
+        // [ <factor> -> NUMBER | IDENTIFIER | '-' <binary(3)> | '(' <expr> ')' ]
+        constexpr int parseFactor()
+        {
+            if (pos >= tokenCount)
+                fail("unexpected end of expression.");
+
+            const Token &t = tokens[pos];
+            if (t.type == TokenType::OPERATOR && t.op == '-')
+            {
+                ++pos;
+                return newOperator('-', -1, parseBinary(3));
+            }
+            if (t.type == TokenType::OPERATOR)
+                fail("missing left operand before the operator");
+            if (t.type == TokenType::ASSIGNMENT)
+                fail("chained assignment is not allowed (found '=' in expression).");
+
+            if (t.type == TokenType::IDENTIFIER || t.type == TokenType::NUMBER)
+            {
+                ++pos;
+                Node n;
+                n.type = t.type;
+                n.value = t.value;
+                n.zero = t.zero;
+                n.slot = t.slot;
+                return newNode(n);
+            }
+
+            if (t.type == TokenType::LEFT_PAREN)
+            {
+                if (pos + 1 < tokenCount && tokens[pos + 1].type == TokenType::RIGHT_PAREN)
+                    fail("empty parenthesis '()' is not a valid factor.");
+                ++pos;
+                const int expr = parseExpr();
+                if (!at(TokenType::RIGHT_PAREN))
+                    fail("missing closing parenthesis.");
+                ++pos;
+                return expr;
+            }
+
+            // ')' or ';' where an operand was expected : after an operator it is a missing operand,
+            // otherwise caller report it (missing ')' or missing ';'), same as Parser
+            if (pos > 0 && tokens[pos - 1].type == TokenType::OPERATOR)
+                fail("missing operand after operator");
+            return -1;
+        }
+    };
+
+    // Parse a formula literal (Use in constexpr context to get compile-time parsing)
+    template <size_t N>
+    constexpr Formula<N> compile(const char (&src)[N])
+    {
+        return Parser<N>(src).run();
+    }
+}
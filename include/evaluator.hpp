@@ -0,0 +1,92 @@
+#pragma once                // Header Guard
+#include "parser.hpp"       // Include Node Definition
+#include "persistent_env.hpp" // Include Versioned Environment
+#include <string>
+#include <vector>
+
+class StateStore;
+
+// Variable slot of an identifier Node (Interned symbol id : 'a' -> 0 ... 'z' -> 25, extended names after)
+inline size_t variableSlot(const Parser::Node *node) { return node->symbol; }
+
+// Integer Arithmetic shared by the interpreter, generated code and compile-time formulas (64-bit, wrap around on overflow)
+namespace compy_arith
+{
+    constexpr long long add(long long a, long long b) { return (long long)((unsigned long long)a + (unsigned long long)b); }
+    constexpr long long sub(long long a, long long b) { return (long long)((unsigned long long)a - (unsigned long long)b); }
+    constexpr long long mul(long long a, long long b) { return (long long)((unsigned long long)a * (unsigned long long)b); }
+
+    // Division : false when divisor is 0 (LLONG_MIN / -1 wrap to LLONG_MIN instead of trapping)
+    constexpr bool div(long long a, long long b, long long &out)
+    {
+        if (b == 0)
+            return false;
+        out = (b == -1) ? sub(0, a) : a / b;
+        return true;
+    }
+
+    // Remainder : false when divisor is 0, sign follow the dividend (LLONG_MIN % -1 is 0 instead of trapping)
+    constexpr bool mod(long long a, long long b, long long &out)
+    {
+        if (b == 0)
+            return false;
+        out = (b == -1) ? 0 : a % b;
+        return true;
+    }
+
+    // Power (Square and multiply, wrap around) : negative exponent truncate 1 / a^-b toward 0, false when a is 0
+    constexpr bool pow(long long a, long long b, long long &out)
+    {
+        if (b < 0)
+        {
+            if (a == 0)
+                return false;
+            out = (a == 1) ? 1 : (a == -1) ? ((b & 1) ? -1 : 1) : 0;
+            return true;
+        }
+        long long result = 1;
+        for (; b > 0; b >>= 1)
+        {
+            if (b & 1)
+                result = mul(result, a);
+            a = mul(a, a);
+        }
+        out = result;
+        return true;
+    }
+
+    long long parseLiteral(const std::string &digits);  // Decimal literal of any length (wrap around)
+}
+
+// Evaluator Class interprets assignment trees built by Parser against a variable environment
+class Evaluator
+{
+
+// Public Member
+public:
+    static const size_t VARIABLE_COUNT = 26;    // a ... z (Environment grow when extended names are assigned)
+
+    Evaluator();                                                        // Constructor (all variable start at 0)
+    bool execute(const Parser::Node *stmt);                             // Run one assignment : Return true when successful
+    bool run(const std::vector<const Parser::Node *> &stmts);           // Run in order, stop at first runtime error
+
+    long long get(size_t slot) const { return versioned ? versioned->get(slot) : slot < vars.size() ? vars[slot] : 0; }   // Read variable (Never assigned = 0)
+    void set(size_t slot, long long value);                             // Write variable (Logged when a journal is set)
+    void setJournal(StateStore *store) { journal = store; }             // Opt-in : every write appended to a persistent log
+    void setEnvironment(PersistentEnv *env) { versioned = env; }        // Opt-in : read / write a forked version instead of the own array
+    const std::vector<long long> &variables() const { return vars; }    // Own array (Versioned writes are in the PersistentEnv)
+
+    bool hasErrors() const { return !runtimeErrors.empty(); }           // Boolean Check runtime error
+    const std::vector<std::string> &getErrors() const { return runtimeErrors; }
+    void printErrors() const;                                           // Print runtime error
+
+// Private Member
+private:
+    std::vector<long long> vars;                // Variable Environment (index by slot)
+    std::vector<std::string> runtimeErrors;     // Store runtime error message
+    StateStore *journal = nullptr;              // Persistent log of writes (nullptr = memory only)
+    PersistentEnv *versioned = nullptr;         // Versioned environment (nullptr = vars)
+
+    bool evaluate(const Parser::Node *root, long long &out);   // Evaluate expression tree
+    bool apply(const Parser::Node *node, long long l, long long r, long long &out);   // One binary operation
+};
@@ -0,0 +1,36 @@
+#pragma once                // Header Guard
+#include "evaluator.hpp"    // Include variableSlot + Node Definition
+#include "integer.hpp"      // Include Integer (int64 fast path, BigInt slow path)
+#include <string>
+#include <vector>
+
+// ExactEvaluator Class interprets the same assignment trees as Evaluator, without wrap around
+// Value stay native int64 while nothing overflow; an overflowing operation is redone in arbitrary precision.
+// RangeAnalysis "proven" flags are not needed here (Every operation is already checked).
+class ExactEvaluator
+{
+
+// Public Member
+public:
+    ExactEvaluator();                                                   // Constructor (all variable start at 0)
+    bool execute(const Parser::Node *stmt);                             // Run one assignment : Return true when successful
+    bool run(const std::vector<const Parser::Node *> &stmts);           // Run in order, stop at first runtime error
+
+    const Integer &get(size_t slot) const { return slot < vars.size() ? vars[slot] : zero; }   // Read variable (Never assigned = 0)
+    void set(size_t slot, const Integer &value);
+    const std::vector<Integer> &variables() const { return vars; }
+
+    bool hasErrors() const { return !runtimeErrors.empty(); }           // Boolean Check runtime error
+    void printErrors() const;                                           // Print runtime error
+
+// Private Member
+private:
+    std::vector<Integer> vars;                  // Variable Environment (index by slot)
+    std::vector<std::string> runtimeErrors;     // Store runtime error message
+    const Integer zero;
+
+    bool evaluate(const Parser::Node *root, Integer &out);     // Evaluate expression tree
+    bool apply(char op, const Integer &l, const Integer &r, Integer &out);   // One binary operation
+    bool check(ArithError err) { return err == ArithError::NONE || fail(err); }    // Return true when the operation succeeded
+    bool fail(ArithError err);                                  // Record runtime error of an operation (Return false)
+};
@@ -0,0 +1,45 @@
+#pragma once                // Header Guard
+#include "token.hpp"        // Include Token Definition
+#include "parser.hpp"       // Include Node Definition
+#include <ostream>
+#include <string>
+#include <vector>
+
+// TreeExporter Class streams token list + syntax tree as JSON, S-expression or Graphviz DOT
+// Traversal is iterative (no recursion) and output goes through one reusable buffer
+class TreeExporter
+{
+
+// Public Member
+public:
+    explicit TreeExporter(std::ostream &os, size_t bufferSize = 64 * 1024);    // Constructor
+    ~TreeExporter();                                                            // Flush remaining output
+
+    void writeJson(const std::vector<Token> &tokens, const Parser::Node *root); // {"tokens":[...],"tree":{...}}
+    void writeSExpr(const Parser::Node *root);                                  // (= x (+ 2 4))
+    void writeDot(const Parser::Node *root);                                    // digraph AST { ... }
+    void flush();                                                               // Push buffer to stream
+
+// Private Member
+private:
+    enum class Format { JSON, SEXPR, DOT };
+
+    // Traversal frame (stage 0 = enter, 1 = left done, 2 = right done)
+    struct Frame
+    {
+        const Parser::Node *node;
+        size_t id;          // Pre-order number (DOT node name)
+        int stage;
+    };
+
+    std::ostream &out;                  // Destination stream
+    std::string buffer;                 // Reusable output buffer
+    size_t capacity;                    // Flush threshold
+    std::vector<Frame> stack;           // Reusable traversal stack (heap, not call stack)
+
+    void walk(const Parser::Node *root, Format format);     // Iterative pre/post-order walk
+    void put(char c);
+    void put(const std::string &s);
+    void putNumber(size_t n);
+    void putQuoted(const std::string &s);                   // "..." with JSON / DOT escape (Output always valid UTF-8)
+};
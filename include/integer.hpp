@@ -0,0 +1,166 @@
+#pragma once                // Header Guard
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// BigInt Class : Arbitrary precision signed integer (sign + magnitude, base 2^32 limbs)
+// Only reached by Integer when a value does not fit 64-bit, so it favour simple over fast.
+class BigInt
+{
+
+// Public Member
+public:
+    BigInt() = default;                                         // 0
+    explicit BigInt(long long value);
+    static BigInt fromDecimal(const std::string &digits);      // Literal of any length
+
+    std::string toString() const;                               // Decimal text
+    bool toInt64(long long &out) const;                         // False when it does not fit
+    bool isZero() const { return limbs.empty(); }
+    bool isNegative() const { return negative; }
+    bool isOdd() const { return !limbs.empty() && (limbs[0] & 1); }
+    size_t bitLength() const;                                   // Bits of the magnitude
+
+    static BigInt add(const BigInt &a, const BigInt &b);
+    static BigInt sub(const BigInt &a, const BigInt &b);
+    static BigInt mul(const BigInt &a, const BigInt &b);
+    static bool divmod(const BigInt &a, const BigInt &b, BigInt &quotient, BigInt &remainder);  // Truncating : false when b = 0
+    BigInt negated() const;
+
+// Private Member
+private:
+    bool negative = false;
+    std::vector<uint32_t> limbs;        // Magnitude, least significant first, no leading zero limb (empty = 0)
+
+    void trim();                        // Drop leading zero limbs (+0 is never negative)
+    static int compareMagnitude(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b);
+    static std::vector<uint32_t> addMagnitude(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b);
+    static std::vector<uint32_t> subMagnitude(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b);   // a >= b
+    static void divideMagnitude(const std::vector<uint32_t> &u, const std::vector<uint32_t> &v, std::vector<uint32_t> &q, std::vector<uint32_t> &r);
+};
+
+// Result of an exact operation
+enum class ArithError : unsigned char
+{
+    NONE,
+    DIVISION_BY_ZERO,
+    TOO_LARGE               // Result would need more than Integer::MAX_BITS bits
+};
+
+// Integer Class : Exact integer for the evaluator, native int64 until an operation overflow
+// Fast path = one __builtin_*_overflow check on two int64; on overflow (or when an operand is already big)
+// the operation is redone in BigInt and the result go back to int64 as soon as it fit again.
+class Integer
+{
+
+// Public Member
+public:
+    static const size_t MAX_BITS = 1u << 20;                    // Bound of one value (~315 000 digits) : hostile '^' / '*' chain stop here
+
+    Integer(long long value = 0) : small(value) {}
+    Integer(const Integer &other) : small(other.small), big(other.big) { if (big) ++big->refs; }
+    Integer &operator=(const Integer &other)
+    {
+        if (other.big)
+            ++other.big->refs;
+        release();
+        small = other.small;
+        big = other.big;
+        return *this;
+    }
+    ~Integer() { release(); }
+    static ArithError fromLiteral(const std::string &digits, Integer &out);    // Decimal literal of any length (TOO_LARGE past MAX_BITS)
+
+    bool isSmall() const { return !big; }
+    long long toInt64() const { return small; }                 // Valid when isSmall()
+    std::string toString() const;
+    bool isZero() const { return !big && small == 0; }
+
+    // Fast path inline (Both operand small + no overflow : no allocation, no count), everything else out of line
+    // (Result go through a local : the builtin store the wrapped value even on overflow, and out may alias an operand)
+    static ArithError add(const Integer &a, const Integer &b, Integer &out)
+    {
+        long long r;
+        if (!a.big && !b.big && !__builtin_add_overflow(a.small, b.small, &r))
+        {
+            out.small = r;
+            out.release();
+            return ArithError::NONE;
+        }
+        return slowAdd(a, b, out);
+    }
+    static ArithError sub(const Integer &a, const Integer &b, Integer &out)
+    {
+        long long r;
+        if (!a.big && !b.big && !__builtin_sub_overflow(a.small, b.small, &r))
+        {
+            out.small = r;
+            out.release();
+            return ArithError::NONE;
+        }
+        return slowSub(a, b, out);
+    }
+    static ArithError mul(const Integer &a, const Integer &b, Integer &out)
+    {
+        long long r;
+        if (!a.big && !b.big && !__builtin_mul_overflow(a.small, b.small, &r))
+        {
+            out.small = r;
+            out.release();
+            return ArithError::NONE;
+        }
+        return slowMul(a, b, out);
+    }
+    static ArithError div(const Integer &a, const Integer &b, Integer &out)    // Truncating (Only LLONG_MIN / -1 overflow on int64)
+    {
+        if (!a.big && !b.big && b.small != 0 && !(a.small == LLONG_MIN && b.small == -1))
+        {
+            const long long r = a.small / b.small;
+            out.release();
+            out.small = r;
+            return ArithError::NONE;
+        }
+        return slowDiv(a, b, out);
+    }
+    static ArithError mod(const Integer &a, const Integer &b, Integer &out)    // Sign follow the dividend (LLONG_MIN % -1 is 0)
+    {
+        if (!a.big && !b.big && b.small != 0)
+        {
+            const long long r = (b.small == -1) ? 0 : a.small % b.small;
+            out.release();
+            out.small = r;
+            return ArithError::NONE;
+        }
+        return slowMod(a, b, out);
+    }
+    static ArithError pow(const Integer &a, const Integer &b, Integer &out);   // Negative exponent : same rule as compy_arith::pow
+    static ArithError negate(const Integer &a, Integer &out);
+
+// Private Member
+private:
+    // Shared BigInt (Immutable once built, so copy only count) : count is not atomic, an Integer stay on one thread
+    struct Shared
+    {
+        BigInt value;
+        mutable size_t refs;
+    };
+
+    long long small;
+    const Shared *big = nullptr;            // Set only when the value does not fit 64-bit
+
+    void release()
+    {
+        if (big && --big->refs == 0)
+            delete big;
+        big = nullptr;
+    }
+    BigInt toBig() const { return big ? big->value : BigInt(small); }
+    static ArithError fromBig(BigInt &&value, Integer &out);   // Back to int64 when it fit, TOO_LARGE past MAX_BITS
+    static ArithError slowAdd(const Integer &a, const Integer &b, Integer &out);
+    static ArithError slowSub(const Integer &a, const Integer &b, Integer &out);
+    static ArithError slowMul(const Integer &a, const Integer &b, Integer &out);
+    static ArithError slowDiv(const Integer &a, const Integer &b, Integer &out);
+    static ArithError slowMod(const Integer &a, const Integer &b, Integer &out);
+};
@@ -1,5 +1,8 @@
 #pragma once                // Header Guard
 #include "token.hpp"        // Include Token Definition
+#include "source_index.hpp" // Include Line:Column Index
+#include "symbol_table.hpp" // Include Identifier Interning
+#include "resource_limits.hpp" // Include Per-statement Budget
 #include <string>
 #include <vector>
 
@@ -22,14 +25,48 @@ private:
     int INVALID;
 
     std::vector<std::string> lexicalErrors;     // Store lexical error message
+    SourceIndex index;                          // Byte offset -> line:column (for diagnostics)
+    SymbolTable *symbols = nullptr;             // Extended identifier mode when set (Multi-character names)
+    const ResourceLimits *limits = nullptr;     // Optional budget (Token count, diagnostics, deadline)
+    ResourceLimits::Kind exceeded = ResourceLimits::Kind::NONE;     // Budget that stopped the scan
+
+    // Token Counter of one scanned range (Reduced into the counter above)
+    struct TokenCounts
+    {
+        int IDENTIFIER = 0;
+        int NUMBER = 0;
+        int OPERATOR = 0;
+        int ASSIGNMENT = 0;
+        int PARENTHESES = 0;
+        int STATEMENT_TERMINATOR = 0;
+        int INVALID = 0;
+        ResourceLimits::Kind stopped = ResourceLimits::Kind::NONE;  // Budget ran out : range scan cut short
+    };
+
+    static const size_t MIN_PARALLEL_CHUNK = 64 * 1024;    // Minimum bytes per thread worth splitting
+
+    void scanRange(size_t begin, size_t end, std::vector<Token> &tokens, TokenCounts &counts) const;   // Tokenize input[begin, end)
+    void addCounts(const TokenCounts &counts);                  // Reduce range counter
+    void collectErrors(const std::vector<Token> &tokens);       // Build lexical error message
+    void internSymbols(std::vector<Token> &tokens);             // Give extended identifiers their symbol id
+    std::vector<Token> exceed(ResourceLimits::Kind kind);       // Record LimitError, return empty Token list
 
 // Public Member
 public:
     explicit Lexer(const std::string &text);    // Constructor new Lexer
+    Lexer(const Lexer &) = delete;              // Index point into the own input : a copy would point into the original
+    Lexer &operator=(const Lexer &) = delete;
     std::vector<Token> tokenize();              // Scan input & returns a vector(list) of Token Object
+    std::vector<Token> tokenizeParallel(unsigned threads = 0);  // Same result, chunks scanned concurrently (0 = all cores)
     void summarize();                           // Prints the summary Tokens Type Count
+    void setSymbolTable(SymbolTable *table) { symbols = table; }   // Opt-in : identifier = letter { letter | digit | '_' }
+    void setLimits(const ResourceLimits *budget) { limits = budget; }  // Opt-in : stop with LimitError instead of scanning everything
+    bool limitExceeded() const { return exceeded != ResourceLimits::Kind::NONE; }  // Token list was dropped (Do not parse)
 
     void printTokenStreamTable(const std::vector<Token> &tokens);       // Print Token Stream Table
     bool hasLexicalErrors() const { return !lexicalErrors.empty(); }    // Boolean Check lexical error
     void printLexicalErrors() const;                                    // Print lexical error
+    const std::vector<std::string> &getLexicalErrors() const { return lexicalErrors; }
+    const SourceIndex &getSourceIndex() const { return index; }         // Line:column of input (share with Parser)
+    static std::string lexicalError(const SourceIndex &index, size_t position, const std::string &text);   // Message of one invalid Token
 };
@@ -0,0 +1,54 @@
+#pragma once                // Header Guard
+#include "evaluator.hpp"    // Include Evaluator (+ Node Definition)
+#include <vector>
+
+// ParallelExecutor Class runs a list of assignments concurrently with the same result as Evaluator::run
+//
+// Every statement write its own result cell, so the only ordering left is read-after-write :
+// statement j wait for the last earlier statement that assigned each variable j reads
+// (write-after-read / write-after-write order disappears because nothing is overwritten).
+// Ready statements go through a work-stealing pool (one deque per worker, owner take oldest so
+// statements run close to source order, idle worker steal newest). On a runtime error the variables end exactly as Evaluator::run
+// leave them : writes of earlier statements only, and the error is logged in the Evaluator.
+class ParallelExecutor
+{
+
+// Public Member
+public:
+    // Dependency graph + run measurement
+    struct Stats
+    {
+        size_t statements = 0;
+        size_t edges = 0;               // Read-after-write dependencies
+        size_t criticalPath = 0;        // Longest dependency chain (statements)
+        unsigned workers = 0;
+        size_t steals = 0;              // Statements taken from another worker
+        double workMs = 0.0;            // Sum of worker busy time (not idle / waiting for work)
+        double wallMs = 0.0;            // Elapsed time of the worker pool
+        double runMs = 0.0;             // Elapsed time of the whole run (Graph build + pool + commit)
+
+        double parallelism() const { return criticalPath ? (double)statements / (double)criticalPath : 0.0; }   // Upper bound of speedup
+        double busy() const { return wallMs > 0.0 ? workMs / wallMs : 0.0; }                                  // Workers busy on average
+    };
+
+    explicit ParallelExecutor(unsigned threads = 0);                            // 0 = all cores
+    bool run(const std::vector<const Parser::Node *> &stmts, Evaluator &env);   // Same as env.run(stmts)
+
+    const Stats &getStats() const { return stats; }
+    void printStats() const;                                                    // Print graph + run summary (Speedup : bench/run_bench.sh parallel)
+
+// Private Member
+private:
+    unsigned threads;
+    Stats stats;
+
+    // Dependency graph (CSR arrays, index by statement)
+    std::vector<int> target;                // Assigned slot (-1 when statement is not an assignment)
+    std::vector<size_t> readBegin;          // reads of j = [readBegin[j], readBegin[j + 1])
+    std::vector<size_t> readSlot;
+    std::vector<long> readFrom;             // Producer statement (-1 = initial environment)
+    std::vector<size_t> succBegin;          // Successors of i = [succBegin[i], succBegin[i + 1])
+    std::vector<size_t> succ;
+
+    void buildGraph(const std::vector<const Parser::Node *> &stmts);
+};
@@ -1,5 +1,8 @@
 #pragma once         // Header Guard
 #include "token.hpp" // Include Token Definition
+#include "source_index.hpp" // Include Line:Column Index
+#include "resource_limits.hpp" // Include Per-statement Budget
+#include <deque>
 #include <vector>
 
 class Parser
@@ -13,11 +16,16 @@ public:
         TokenType type;       // Token Type (NUM,ID,OP)
 
         // Default member initialization
-        Node *left = nullptr;
+        Node *left = nullptr;         // nullptr for unary minus (operand is right)
         Node *right = nullptr;
+        int position = -1;            // Source offset of the Token (-1 for error Node)
+        uint32_t symbol = NO_SYMBOL;  // Interned id of IDENTIFIER (Variable slot)
+
+        // Analysis annotation (Set by RangeAnalysis) : operation proven to never divide by zero or overflow
+        bool proven = false;
 
         // Constructor (Check parameter format must be same)
-        Node(const std::string &val, TokenType t, Node *l = nullptr, Node *r = nullptr) : value(val), type(t), left(l), right(r) {}
+        Node(const std::string &val, TokenType t, Node *l = nullptr, Node *r = nullptr, int p = -1) : value(val), type(t), left(l), right(r), position(p) {}
     };
 
     explicit Parser(const std::vector<Token> &toks);        // Contructor
@@ -28,6 +36,13 @@ public:
     void reportError(const std::string &msg);               // Log Syntax Error Message
     void reportError(const std::string &msg, int position); // Same log but with position (overload)
     void printErrors() const;                               // Print all logged error (can print more than 1)
+    const std::vector<std::string> &getErrors() const { return errorMessages; }   // Logged error messages
+    const Node *getRoot() const { return root; }            // Root of the first parsed statement (nullptr if none)
+    Node *getRoot() { return root; }                        // Same, for passes that rewrite the tree (Reassociate)
+    void setSourceIndex(const SourceIndex *idx) { index = idx; }   // Report line:column instead of byte position
+    void setLimits(const ResourceLimits *budget) { limits = budget; }  // Opt-in : stop with LimitError (Token, depth, Node, error, time)
+    bool limitExceeded() const { return exceeded != ResourceLimits::Kind::NONE; }  // Tree was dropped by a budget
+    static std::string formatError(const std::string &msg, int position, const SourceIndex *index);  // "SyntaxError at ...: msg"
 
     // Tree Display Check
     struct cell_display
@@ -56,17 +71,38 @@ private:
     const std::vector<Token> &tokens;
     size_t pos;
     Node *root = nullptr;
+    const SourceIndex *index = nullptr;     // Optional line:column index of the source
+    std::deque<Node> nodes;                 // Every Node of the tree (Stable address, all released with the Parser)
+
+    // Resource Budget (Untrusted input)
+    const ResourceLimits *limits = nullptr;
+    ResourceLimits::Kind exceeded = ResourceLimits::Kind::NONE;
+    size_t depth = 0;                                       // Current nesting ('(' , unary '-', '^' operand)
+    Node *makeNode(const std::string &val, TokenType t, Node *l = nullptr, Node *r = nullptr, int p = -1);  // Node count + clock check
+    void exceedLimit(ResourceLimits::Kind kind);            // Log LimitError, then skip to end of Token
+    bool enterNested();                                     // Depth + 1 : false when depth budget spent
+    void leaveNested() { --depth; }
 
     // Main Parsing Function
     Node *parseStatement();
     Node *parseExpr();
-    Node *parseTerm();
+    Node *parseBinary(int minPrecedence);               // Precedence climbing over the operator table
+    Node *parseRightChain(Node *first, int precedence); // Run of right associative operators (Folded without recursion)
     Node *parseFactor();
 
     // Error Handling Function
     bool errorOccurred = false;
     std::vector<std::string> errorMessages;
 
+    // Panic-mode Recovery (FIRST/FOLLOW synchronization sets, each Token examined a bounded number of times)
+    bool panicMode = false;                                 // True after an error until a Token is matched
+    unsigned peekKind() const;                              // Kind bit of current Token
+    void syntaxError(const std::string &msg, int position); // Log error unless already in panic mode
+    void synchronize(unsigned followSet);                   // Skip Token until FOLLOW set (or ';')
+    void skipInvalid();                                     // Skip Token already reported by Lexer
+    void skipMisplaced();                                   // Report + skip operator / '=' where a factor is expected
+
     // Tree calculation
+    static const int MAX_DISPLAY_HEIGHT = 9;                // With limits, taller tree is not drawn (Width double per level)
     int getTreeHeight(const Node *node) const;
 };
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once                // Header Guard
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// PersistentEnv Class : Variable environment (slot -> 64-bit value) with O(1) fork
+// 32-way radix trie (5 bits of the slot per level, leaves hold 32 values). Copy = fork : share the root
+// and bump one count. A write copy only the nodes on its path that are still shared with another
+// version (Node used by this version alone is updated in place), so every fork of a base keep the
+// unchanged part of the base in common. Counts are atomic : versions can live on different threads,
+// one version itself is not thread-safe (same as std::vector).
+class PersistentEnv
+{
+
+// Public Member
+public:
+    static const unsigned BITS = 5;
+    static const size_t WIDTH = (size_t)1 << BITS;          // Slots per leaf / children per branch
+
+    PersistentEnv() = default;                              // Every variable 0, no node
+    PersistentEnv(const PersistentEnv &other);              // Fork (O(1))
+    PersistentEnv(PersistentEnv &&other) noexcept;
+    PersistentEnv &operator=(PersistentEnv other);
+    ~PersistentEnv();
+
+    PersistentEnv fork() const { return *this; }
+
+    long long get(size_t slot) const;                       // Never assigned = 0
+    void set(size_t slot, long long value);                 // Copy shared nodes on the path, then write
+    size_t capacity() const { return root ? (size_t)1 << (BITS * (levels + 1)) : 0; }   // Slots addressable without growing
+
+    // Slots whose value differ from base (Subtree shared with base is skipped without being read)
+    std::vector<std::pair<size_t, long long>> changes(const PersistentEnv &base) const;
+
+    static size_t liveNodes() { return nodeCount.load(std::memory_order_relaxed); }   // Nodes alive in every version
+    static const size_t NODE_BYTES;                         // Size of one node (Leaf and Branch are the same size)
+
+// Private Member
+private:
+    struct Node
+    {
+        std::atomic<uint32_t> refs{1};                      // Versions + parent nodes pointing here
+    };
+    struct Leaf : Node
+    {
+        long long values[WIDTH] = {};
+    };
+    struct Branch : Node
+    {
+        Node *child[WIDTH] = {};
+    };
+
+    Node *root = nullptr;
+    unsigned levels = 0;                                    // Branch levels above the leaves (0 = root is a leaf)
+
+    static std::atomic<size_t> nodeCount;
+
+    static void retain(Node *node) { if (node) node->refs.fetch_add(1, std::memory_order_relaxed); }
+    static void release(Node *node, unsigned level);        // Drop one reference (Free subtree on the last one)
+    static Node *unshare(Node *node, unsigned level);       // Node writable by this version (node itself when not shared)
+    static void diff(const Node *a, unsigned aLevel, const Node *b, unsigned bLevel, unsigned level, size_t offset,
+                     std::vector<std::pair<size_t, long long>> &out);
+};
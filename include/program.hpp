@@ -0,0 +1,53 @@
+#pragma once                // Header Guard
+#include "token.hpp"        // Include Token Definition
+#include "parser.hpp"       // Include Parser (Node Definition)
+#include "symbol_table.hpp" // Include Identifier Interning
+#include "reassociate.hpp"  // Include Chain Rebalancing
+#include "range_analysis.hpp" // Include Interval Analysis
+#include <memory>
+#include <string>
+#include <vector>
+
+// Program Class splits a source text into statements (one per ';') and parses each one on its own Parser
+class Program
+{
+
+// Public Member
+public:
+    explicit Program(const std::string &text, SymbolTable *symbols = nullptr);   // Constructor (symbols = extended identifier mode)
+    bool compile();                             // Lex + parse every statement : Return true when all valid
+    void setLimits(const ResourceLimits &budget) { limits = budget; limited = true; }  // Budget of each statement (Token, depth, Node, error, time)
+    void setExact(bool on) { exact = on; }      // Values may pass 64-bit (ExactEvaluator) : no RangeAnalysis, its interval are 64-bit
+    void setBalance(bool on) { balance = on; }  // Rebalance + - * chains after the diagnostics (Logarithmic height)
+    const Reassociate &reassociation() const { return chains; }
+    const RangeAnalysis &analysis() const { return ranges; }    // Runtime checks proven away (Nothing analyzed in exact mode)
+
+    size_t size() const { return roots.size(); }                                    // Number of parsed statements
+    const Parser::Node *statement(size_t i) const { return roots[i]; }              // Tree of statement i
+    const std::vector<const Parser::Node *> &statements() const { return roots; }   // All statement trees
+
+    bool hasErrors() const { return !errors.empty(); }                  // Boolean Check lexical or syntax error
+    const std::vector<std::string> &getErrors() const { return errors; }
+    void printErrors() const;                                           // Print all collected errors
+
+// Private Member
+private:
+    // One statement : own token list + the Parser that refers to it (Parser keep reference to tokens)
+    struct Unit
+    {
+        std::vector<Token> tokens;
+        std::unique_ptr<Parser> parser;
+    };
+
+    std::string source;                             // Full source text
+    SymbolTable *symbols;                           // Names of extended identifiers (nullptr = single letter)
+    ResourceLimits limits;                          // Per-statement budget (Clock restarted for every statement)
+    bool limited = false;
+    bool exact = false;
+    bool balance = false;
+    Reassociate chains;                             // Rebalancing pass + its stats
+    RangeAnalysis ranges;                           // Interval analysis of the last compile + its stats
+    std::vector<std::unique_ptr<Unit>> units;       // Stable address so Parser reference stay valid
+    std::vector<const Parser::Node *> roots;        // Tree of each valid statement (in order)
+    std::vector<std::string> errors;                // Lexical + syntax error messages (in order)
+};
@@ -0,0 +1,52 @@
+#pragma once                // Header Guard
+#include "parser.hpp"       // Include Node Definition
+#include <string>
+#include <vector>
+
+// Closed integer range [lo, hi] of a 64-bit value
+struct Interval
+{
+    long long lo;
+    long long hi;
+
+    static Interval full();                                 // Any value (unknown variable)
+    static Interval exact(long long v) { return Interval{v, v}; }
+    bool contains(long long v) const { return lo <= v && v <= hi; }
+};
+
+// RangeAnalysis Class runs interval analysis over statement trees (Static, nothing is executed)
+// Proves divisors non-zero and results free of overflow, marks those Nodes as proven so
+// Evaluator / CodeGen can skip the runtime check, and finds divisions that always divide by zero
+class RangeAnalysis
+{
+
+// Public Member
+public:
+    // Definite error found by the analysis (position = source offset of the operator)
+    struct Diagnostic
+    {
+        std::string message;
+        int position;
+    };
+
+    RangeAnalysis();                                        // Constructor (every variable unknown)
+    bool analyze(Parser::Node *stmt);                       // Analyze one assignment + update variable range : false when definite error
+    bool analyze(const std::vector<Parser::Node *> &stmts); // Analyze statements in order
+
+    const std::vector<Diagnostic> &getDiagnostics() const { return diagnostics; }
+    Interval rangeOf(size_t slot) const { return slot < vars.size() ? vars[slot] : Interval::full(); }    // Range of variable after analyzed statements
+
+    size_t checkCount() const { return checks; }            // Arithmetic operations needing a runtime check
+    size_t provenCount() const { return proven; }           // ... of which proven safe
+    void printStats() const;                                // Print percentage of check removed
+
+// Private Member
+private:
+    std::vector<Interval> vars;                 // Range of each variable (index by slot)
+    std::vector<Diagnostic> diagnostics;        // Definite errors
+    size_t checks;
+    size_t proven;
+
+    Interval evaluate(Parser::Node *root);                  // Range of expression (annotate Node on the way)
+    Interval combine(Parser::Node *node, const Interval &a, const Interval &b);   // Range of one operation (a unused for unary minus)
+};
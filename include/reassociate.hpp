@@ -0,0 +1,48 @@
+#pragma once                // Header Guard
+#include "parser.hpp"       // Include Node Definition
+#include <cstddef>
+#include <vector>
+
+// Reassociate Class rebalances chains of associative operators into trees of logarithmic height (Opt-in, after RangeAnalysis)
+//
+// Chain = connected '+' / '-' Nodes (each operand keep its sign : a - (b - c) is a - b + c), or connected '*' Nodes.
+// '/', '%', '^' and unary minus are barriers (Not associative under truncation / not the same operator) : their
+// operands are rebalanced on their own. Value is unchanged because 64-bit wrap around arithmetic is a ring (same for
+// exact integers). The Nodes of a chain are reused for its new shape, so nothing is allocated and the Parser keep
+// ownership. Diagnostics are produced before the pass; "proven" is cleared on rebuilt Nodes (Their operands changed),
+// and kept on barriers (Their operand values are the same).
+class Reassociate
+{
+
+// Public Member
+public:
+    Parser::Node *run(Parser::Node *root);                 // Rebalance one statement in place : Return new root
+
+    size_t chainCount() const { return chains; }            // Chains rebuilt
+    size_t operandCount() const { return operands; }        // Operands in those chains
+    size_t heightBefore() const { return before; }          // Tallest statement before / after (Nodes on the longest path)
+    size_t heightAfter() const { return after; }
+    void printStats() const;                                // Print chain count + height
+
+// Private Member
+private:
+    struct Operand
+    {
+        Parser::Node *node;
+        Parser::Node **slot;                                // Child pointer holding it in the old shape
+        bool negative;                                      // Subtracted ('+' / '-' chain only)
+    };
+
+    size_t chains = 0;
+    size_t operands = 0;
+    size_t before = 0;
+    size_t after = 0;
+
+    std::vector<Parser::Node **> work;                     // Child pointers still to visit (Explicit stack : chain can be very long)
+    std::vector<Operand> terms;                             // Operands of the current chain (Left to right)
+    std::vector<Parser::Node *> ops;                        // Operator Nodes of the current chain (Reused)
+
+    void flatten(Parser::Node **slot, bool additive);      // Collect operands + operator Nodes of the chain at *slot
+    void build(size_t lo, size_t hi, bool flip, bool additive, Parser::Node **slot);   // Balanced tree of terms [lo, hi) into *slot
+    static size_t height(const Parser::Node *root);         // Iterative (Tree before the pass can be very deep)
+};
@@ -0,0 +1,53 @@
+#pragma once                // Header Guard
+#include "source_index.hpp" // Include Line:Column Index
+#include <cstddef>
+#include <string>
+
+// Recognizer Class : Validation only (valid / invalid + first diagnostic), straight over the source bytes
+// Table-driven pushdown automaton (the only stack symbol is '(' so the stack is a depth counter).
+// Nothing is allocated and no tree is built; the message text is only formatted when asked for.
+//
+// Verdict is the same as Lexer::tokenize + Parser::parse : valid when there is no lexical error and
+// parse() succeed. The first diagnostic is the first line main would print (lexical error first,
+// else the first syntax error). RangeAnalysis is not run (divisor like "(b - b)" is not checked).
+class Recognizer
+{
+
+// Public Member
+public:
+    // First diagnostic (Same wording as Lexer / Parser)
+    enum class Code : unsigned char
+    {
+        NONE,               // Valid
+        LEXICAL,            // Invalid character (reported by Lexer)
+        EMPTY_INPUT,
+        BAD_START,          // Statement must start with an identifier
+        MISSING_ASSIGN,
+        DOUBLE_ASSIGN,      // "=="
+        MISSING_RHS,
+        MISSING_LEFT_OPERAND,
+        CHAINED_ASSIGN,
+        UNEXPECTED_END,
+        EMPTY_PAREN,
+        MISSING_OPERAND,    // Operator without right operand
+        MISSING_OPERATOR,
+        MISSING_CLOSE,
+        MISSING_TERMINATOR,
+        DIVISION_BY_ZERO,
+        EXTRA_STATEMENT     // More expressions after ';'
+    };
+
+    struct Result
+    {
+        bool valid = true;
+        Code code = Code::NONE;
+        int position = -1;          // Source offset of the diagnostic (-1 = end of input, same as Parser)
+        size_t length = 0;          // Length of the Token quoted in the message (0 when none)
+
+        explicit operator bool() const { return valid; }
+    };
+
+    static Result check(const char *data, size_t size, bool extended = false);      // Validate one source text (extended = multi-character names)
+    static Result check(const std::string &source, bool extended = false) { return check(source.data(), source.size(), extended); }
+    static std::string message(const std::string &source, const Result &result);     // Full diagnostic line ("" when valid)
+};
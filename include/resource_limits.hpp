@@ -0,0 +1,30 @@
+#pragma once                // Header Guard
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+// ResourceLimits Class : Per-statement budget for untrusted input (0 = no limit)
+// Lexer and Parser check it while they work (counter compare, clock read only every few thousand step)
+// and stop with one "LimitError" diagnostic when a budget run out, releasing the Token / Node built so far.
+class ResourceLimits
+{
+
+// Public Member
+public:
+    enum class Kind : unsigned char { NONE, TOKENS, DEPTH, NODES, DIAGNOSTICS, DEADLINE };
+
+    size_t maxTokens = 0;           // Token of one statement
+    size_t maxDepth = 0;            // Nesting of '(' , unary '-' and '^' operand, and height of the tree
+    size_t maxNodes = 0;            // Syntax tree Node
+    size_t maxDiagnostics = 0;      // Error message kept before giving up
+    unsigned timeoutMs = 0;         // Wall clock from start()
+
+    static ResourceLimits untrusted();                  // Default budget for input from outside (main --limits)
+    void start();                                       // Start the clock of the next statement (Call before lexing it)
+    bool expired() const { return timeoutMs && std::chrono::steady_clock::now() >= deadline; }
+    std::string message(Kind kind) const;               // "LimitError: ..." text of a budget that ran out
+
+// Private Member
+private:
+    std::chrono::steady_clock::time_point deadline;
+};
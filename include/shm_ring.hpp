@@ -0,0 +1,85 @@
+#pragma once                // Header Guard
+#include "recognizer.hpp"   // Verdict published back to the producer
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ShmRing Class : Statement ingestion through shared memory, for producers on the same machine
+// One named POSIX shared-memory object (shm_open + mmap) hold bounded rings of fixed-size slots :
+//   request ring   : producer copy one statement into a free slot, compiler lex + parse it in place (no copy, no Token)
+//   response rings : one per attached producer; compiler publish the verdict (request id + Recognizer::Result fields)
+//                    into the ring of the producer named in the request, only that producer collect it
+// Every slot carry a sequence number and a position is claimed with one CAS, so any number of compiler threads and
+// up to MAX_PRODUCERS producers (open) can share a region. A producer keep at most one ring of statements in flight,
+// so its response ring never fill up and a slow producer cannot hold the compiler threads of the others.
+class ShmRing
+{
+
+// Public Member
+public:
+    static const size_t SLOT_BYTES = 236;                   // Longest statement a request slot can hold (Slot = 256 bytes)
+    static const size_t DEFAULT_SLOTS = 4096;               // Slots per ring (Power of 2)
+    static const uint32_t MAX_PRODUCERS = 16;               // Response rings per region (Producers attached at once)
+
+    // Statement borrowed from the request ring (Valid until release)
+    struct Request
+    {
+        uint64_t id = 0;
+        uint32_t producer = 0;                              // Response ring of the sender
+        const char *data = nullptr;
+        size_t size = 0;                                    // Never more than SLOT_BYTES
+        uint64_t position = 0;                              // Ring position, given back to release
+    };
+
+    struct Response
+    {
+        uint64_t id = 0;
+        uint32_t producer = 0;                              // Copied from the Request
+        Recognizer::Result result;
+    };
+
+    ShmRing() = default;
+    ~ShmRing();                                             // Detach producer + unmap (Object itself stay until unlink)
+    ShmRing(const ShmRing &) = delete;
+    ShmRing &operator=(const ShmRing &) = delete;
+
+    bool create(const std::string &name, size_t slots = DEFAULT_SLOTS);    // New empty region (Replace a stale one)
+    bool open(const std::string &name);                     // Attach to a region made by create, as one producer
+    static void unlink(const std::string &name);            // Remove the name (Mapped regions stay usable)
+
+    // Producer side
+    bool submit(uint64_t id, const char *text, size_t size);    // false = ring full or one ring in flight (size must be <= SLOT_BYTES)
+    bool collect(Response &out);                            // false = no response waiting for this producer
+
+    // Compiler side
+    bool acquire(Request &out);                             // false = no request waiting
+    void release(const Request &request);                   // Slot back to producers
+    bool publish(const Response &response);                 // false = response ring of the producer full (Unknown producer : dropped)
+
+    void stop();                                            // Ask every compiler thread to finish
+    bool stopped() const;
+    const std::string &getError() const { return error; }
+
+    static void backoff(unsigned &idle);                    // Wait a little longer each empty poll (spin, yield, sleep)
+
+// Private Member
+private:
+    struct Header;
+    struct RequestSlot;
+    struct ResponseSlot;
+    struct ResponseQueue;
+
+    void *base = nullptr;
+    size_t bytes = 0;
+    Header *header = nullptr;
+    RequestSlot *requests = nullptr;
+    ResponseSlot *responses = nullptr;
+    uint64_t mask = 0;                                      // slots - 1
+    uint32_t producer = MAX_PRODUCERS;                      // Own response ring (MAX_PRODUCERS = not a producer)
+    uint64_t inFlight = 0;                                  // Submitted, response not collected yet
+    std::string error;
+
+    bool map(int fd, size_t size);
+    void layout();                                          // Ring pointers from base
+    static size_t regionBytes(size_t slots);
+};
@@ -0,0 +1,43 @@
+#pragma once                // Header Guard
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// UTF-8 helpers (Input from upstream producers may contain multi-byte characters)
+namespace utf8
+{
+    size_t skipAscii(const char *data, size_t size, size_t from);          // Index of next byte >= 0x80 (SIMD, size when none)
+    size_t decode(const char *data, size_t size, size_t at, bool &valid);  // Byte length of code point at 'at'
+}
+
+// SourceIndex Class maps byte offsets to line:column (Built lazily from a newline bitmap)
+class SourceIndex
+{
+
+// Public Member
+public:
+    SourceIndex(const char *text, size_t length);      // Constructor (Nothing scanned yet)
+
+    struct Location
+    {
+        size_t line;        // 1-based line
+        size_t column;      // 1-based column (count code points, not bytes)
+    };
+
+    Location locate(size_t offset) const;                   // Line:column of a byte offset
+    std::string describe(size_t offset) const;              // "line L, column C"
+
+// Private Member
+private:
+    const char *data;                                       // Source text (not owned)
+    size_t size;                                            // Source length in bytes
+    mutable bool built;                                     // Bitmap built yet?
+    mutable std::vector<uint64_t> newlineBits;              // Bit i set when data[i] == '\n'
+    mutable std::vector<uint32_t> newlineRank;              // Newlines before each 64-bit word
+    mutable bool cacheValid;                                // Previous lookup (sequential lookups stay linear)
+    mutable size_t cacheOffset;
+    mutable Location cacheLine;
+
+    void build() const;                                     // Scan once for '\n' (SIMD)
+    size_t lineStart(size_t offset) const;                  // Byte offset where the line of 'offset' begin
+};
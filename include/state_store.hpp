@@ -0,0 +1,52 @@
+#pragma once                // Header Guard
+#include "evaluator.hpp"    // Include Variable Environment
+#include "symbol_table.hpp" // Include Identifier Interning
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// StateStore Class keeps the variable environment on disk, so a restart does not replay the whole program
+//
+//   <base>.snap : snapshot = checksummed header, every variable value, names of extended identifiers (memory-mapped on load)
+//   <base>.log  : append-only log of every assignment after the snapshot (16-byte checksummed record, new names too)
+//
+// load() map the snapshot then replay the log (torn record at the end, left by a crash, is cut off; a bad record
+// with data after it is corruption and load fail). snapshot() write the new file beside the old one, rename it
+// over (atomic) and empty the log; replaying a log twice give the same state.
+class StateStore
+{
+
+// Public Member
+public:
+    static const size_t SNAPSHOT_EVERY = 1000000;           // Log record count worth a new snapshot
+
+    explicit StateStore(const std::string &basePath, SymbolTable *symbols = nullptr);  // symbols = extended names kept too
+    ~StateStore();                                          // Flush + close log
+
+    bool load(Evaluator &env);                              // Restore env (No file = empty state) : false when snapshot is corrupt
+    bool append(size_t slot, long long value);              // Log one assignment (Buffered until flush)
+    bool flush();                                           // Push log to disk
+    bool snapshot(const Evaluator &env);                    // Write snapshot of env, then empty the log
+
+    size_t logRecords() const { return records; }           // Assignments in log since last snapshot
+    uint64_t assignments() const { return total; }          // Assignments ever applied (snapshot + log)
+    double loadMs() const { return loadTime; }              // Time spent in load()
+    const std::string &getError() const { return error; }
+
+// Private Member
+private:
+    std::string snapPath;
+    std::string logPath;
+    SymbolTable *symbols;
+    std::FILE *log = nullptr;
+    size_t records = 0;
+    uint64_t total = 0;
+    uint32_t loggedNames = SymbolTable::SINGLE_LETTERS;    // Names below this id are in snapshot or log already
+    double loadTime = 0.0;
+    std::string error;
+
+    bool loadSnapshot(Evaluator &env);
+    bool replayLog(Evaluator &env);
+    bool openLog(const char *mode);
+    bool restoreName(uint32_t id, const char *text, size_t length);    // Intern name, must get the same id again
+};
@@ -0,0 +1,59 @@
+#pragma once                // Header Guard
+#include "token.hpp"        // Include NO_SYMBOL
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// PerfectHash Class : Collision-free hash of a fixed set of names (Hash and displace)
+// Each bucket store one seed chosen at build time so that every name of the set land on its own
+// index in [0, n) : lookup is two hash + one table read, never a probe sequence.
+class PerfectHash
+{
+
+// Public Member
+public:
+    bool build(const std::vector<std::string> &keys);          // Names must be distinct : false when no seed found
+    size_t indexOf(const char *text, size_t length) const;      // Index of a name of the set (Unknown name : any index, caller verify)
+    size_t size() const { return count; }
+
+    static uint64_t hash(const char *text, size_t length, uint64_t seed);  // Seeded 64-bit string hash
+
+// Private Member
+private:
+    size_t count = 0;
+    std::vector<uint32_t> seeds;        // Seed of each bucket
+};
+
+// SymbolTable Class interns identifier names into dense 32-bit id (Environment stay a flat array index by id)
+// 'a' ... 'z' are always id 0 ... 25, so single letter programs get the same slot as before.
+class SymbolTable
+{
+
+// Public Member
+public:
+    static const uint32_t SINGLE_LETTERS = 26;
+    static const size_t PERFECT_HASH_LIMIT = 1 << 16;          // Bigger sets keep probing (Build time grow faster than linear)
+
+    SymbolTable();                                              // Constructor (a ... z interned)
+    uint32_t intern(const char *text, size_t length);           // Id of name (New id when first seen)
+    uint32_t intern(const std::string &name) { return intern(name.data(), name.size()); }
+    uint32_t find(const char *text, size_t length) const;       // Id of name, NO_SYMBOL when never interned
+
+    const std::string &name(uint32_t id) const { return names[id]; }
+    size_t size() const { return names.size(); }
+
+    bool usePerfectHash(const std::vector<std::string> &known); // Intern known variable set + build perfect hash over every name so far
+                                                                // (Kept as is when no name was interned since the last build)
+    bool hasPerfectHash() const { return perfect.size() != 0; }
+
+// Private Member
+private:
+    std::vector<std::string> names;     // id -> name
+    std::vector<uint32_t> slots;        // Open addressing table of id (Size power of 2, NO_SYMBOL = empty)
+    PerfectHash perfect;                // Optional : known names found without probing
+    std::vector<uint32_t> perfectIds;   // Perfect hash index -> id
+    size_t perfectNames = 0;            // Names when the perfect hash was last built (0 = never)
+
+    bool matches(uint32_t id, const char *text, size_t length) const;
+    void insertSlot(uint32_t id);
+};
@@ -1,6 +1,9 @@
 #pragma once                // Header Guard
+#include <cstdint>
 #include <string>
 
+const uint32_t NO_SYMBOL = 0xFFFFFFFFu;    // Symbol id of a Token that is not an identifier
+
 // Define Categories for token (Refer assignment Requirement)
 enum class TokenType
 {
@@ -14,6 +17,32 @@ enum class TokenType
     INVALID
 };
 
+// Operator of an OPERATOR Token (Index of the Parser operator table, no string compare while parsing)
+enum class OpKind : unsigned char
+{
+    ADD,        // +
+    SUB,        // - (binary, or unary minus in operand position)
+    MUL,        // *
+    DIV,        // /
+    MOD,        // %
+    POW,        // ^ (right associative)
+    NONE        // Not an operator
+};
+
+inline OpKind opKindOf(char c)
+{
+    switch (c)
+    {
+    case '+': return OpKind::ADD;
+    case '-': return OpKind::SUB;
+    case '*': return OpKind::MUL;
+    case '/': return OpKind::DIV;
+    case '%': return OpKind::MOD;
+    case '^': return OpKind::POW;
+    default:  return OpKind::NONE;
+    }
+}
+
 // Represent a single token scanned from the source code (almost like a pointer)
 struct Token
 {
@@ -21,7 +50,13 @@ struct Token
     std::string value;      // Current Token Value
     size_t start_pos = 0;   // Starting character index
     size_t length = 0;      // Length of token text
+    uint32_t symbol = NO_SYMBOL;    // Interned id of IDENTIFIER (Variable slot)
+    OpKind op = OpKind::NONE;       // Operator of OPERATOR Token
 
     // Token Constructor
-    Token(TokenType t, std::string v, size_t sp) : type(t), value(std::move(v)), start_pos(sp), length(v.size()) {}
+    Token(TokenType t, std::string v, size_t sp) : type(t), value(std::move(v)), start_pos(sp), length(value.size())
+    {
+        if (type == TokenType::OPERATOR)
+            op = opKindOf(value[0]);
+    }
 };
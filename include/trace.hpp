@@ -0,0 +1,51 @@
+#pragma once                // Header Guard
+#include <cstdint>
+#include <ostream>
+
+// Tracing (Chrome trace-event JSON, open in Perfetto or about://tracing)
+// Each thread write its spans into its own lock-free ring buffer (oldest overwritten when full).
+// Only one statement out of every N is recorded, so it can stay on in production.
+// Worker threads record for the statement that handed them their task (TraceTask passed along with it).
+
+// TraceTask Struct : Statement a task belong to (Sampling decision made by the thread that started the statement)
+struct TraceTask
+{
+    bool sampled = false;
+    uint64_t statement = 0;
+};
+
+// Trace Class : Global switch, statement sampling and dump
+class Trace
+{
+
+// Public Member
+public:
+    static void enable(unsigned sampleEvery = 1);       // Start recording (1 = every statement)
+    static void disable();                              // Stop recording (buffers are kept for dump)
+    static bool isEnabled();
+
+    static void beginStatement();                       // Decide if next statement of this thread is sampled
+    static bool sampled();                              // Current statement of this thread is recorded?
+    static TraceTask task();                            // Current statement of this thread (To hand to a worker)
+    static void adopt(const TraceTask &task);           // Worker thread : record (or not) as part of that statement
+
+    static void writeChromeJson(std::ostream &out);     // Dump every thread buffer (call when spans are quiet)
+};
+
+// TraceSpan Class : Record one complete event from constructor to destructor
+// (Name must be a string literal; cost one thread-local check when not sampled)
+class TraceSpan
+{
+
+// Public Member
+public:
+    explicit TraceSpan(const char *name);
+    ~TraceSpan();
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+// Private Member
+private:
+    const char *name;       // nullptr when not recording
+    uint64_t start;         // Start time (ns)
+};
@@ -0,0 +1,412 @@
+#include "../include/alloc_trace.hpp"   // Reference to Class header
+
+#ifdef COMPY_ALLOC_TRACE
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+
+#ifndef _WIN32
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#endif
+
+// 1. Tracer state (Fixed size tables : the hooks themselves never allocate)
+namespace
+{
+    const int MAX_PHASES = 16;
+    const size_t MAX_SITES = 1024;          // Power of 2 (open addressing)
+    const size_t MAX_FRAMES = 4096;         // Frames already classified (Power of 2)
+    const int STACK_DEPTH = 16;             // Frames walked to find the COMPY caller
+    const size_t HEADER = 32;               // Block prefix, keep malloc alignment (16)
+
+    struct PhaseStats
+    {
+        const char *name;
+        std::atomic<size_t> allocs;
+        std::atomic<size_t> frees;
+        std::atomic<size_t> bytes;          // Bytes allocated this statement
+        std::atomic<size_t> live;           // Bytes still alive
+        std::atomic<size_t> peak;           // Highest live this statement
+    };
+
+    struct SiteStats
+    {
+        std::atomic<void *> site;           // First COMPY frame above operator new (Not libstdc++ / libc / std:: template)
+        std::atomic<size_t> allocs;
+        std::atomic<size_t> bytes;
+    };
+
+    // Return address already classified : own = 1 COMPY code, 2 library code
+    struct FrameKind
+    {
+        std::atomic<void *> frame;
+        std::atomic<int> own;
+    };
+
+    // Prefix written in front of every block (Right before the pointer handed out, whatever its alignment)
+    struct Header
+    {
+        size_t size;
+        void *raw;                          // What malloc returned (Aligned block start further)
+        int phase;                          // -1 when made by the tracer (not counted)
+    };
+
+    PhaseStats phases[MAX_PHASES];          // Index 0 = allocation outside any AllocPhase
+    std::atomic<int> phaseCount(1);
+    std::atomic_flag registerLock = ATOMIC_FLAG_INIT;
+    SiteStats sites[MAX_SITES];
+    FrameKind frames[MAX_FRAMES];
+    std::atomic<size_t> statementAllocs(0);
+    std::atomic<size_t> liveBytes(0);
+    std::atomic<size_t> statementPeak(0);
+
+    thread_local int currentPhase = 0;
+    thread_local bool inHook = false;       // True while the tracer itself allocate (report, demangle)
+
+    // 1.1 Raise peak to value (Lock-free max)
+    void raisePeak(std::atomic<size_t> &peak, size_t value)
+    {
+        size_t seen = peak.load(std::memory_order_relaxed);
+        while (value > seen && !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // 1.2 Find (or claim) the slot of an allocation site
+    SiteStats *siteOf(void *site)
+    {
+        size_t h = ((size_t)site >> 4) * 0x9E3779B97F4A7C15ULL;
+        for (size_t probe = 0; probe < MAX_SITES; ++probe)
+        {
+            SiteStats &s = sites[(h + probe) & (MAX_SITES - 1)];
+            void *cur = s.site.load(std::memory_order_relaxed);
+            if (cur == site)
+                return &s;
+            if (!cur && s.site.compare_exchange_strong(cur, site, std::memory_order_relaxed))
+                return &s;
+            if (cur == site)
+                return &s;
+        }
+        return nullptr; // Table full : site not recorded
+    }
+
+    // 1.3 Frame of COMPY code : inside the executable and not a std:: / __gnu_cxx:: template or operator new built
+    //     there (Mangled prefix checked, no demangling). Without -rdynamic static symbols have no name : executable only.
+    bool ownFrame(void *frame)
+    {
+#ifndef _WIN32
+        size_t h = ((size_t)frame >> 2) * 0x9E3779B97F4A7C15ULL;
+        FrameKind *slot = nullptr;
+        for (size_t probe = 0; probe < 8 && !slot; ++probe)
+        {
+            FrameKind &k = frames[(h + probe) & (MAX_FRAMES - 1)];
+            void *cur = k.frame.load(std::memory_order_acquire);
+            if (cur == frame)
+            {
+                const int own = k.own.load(std::memory_order_acquire);
+                if (own)
+                    return own == 1;
+                slot = &k;
+            }
+            else if (!cur && k.frame.compare_exchange_strong(cur, frame, std::memory_order_acq_rel))
+                slot = &k;
+        }
+
+        // Load address of the program (Frames outside it are shared libraries)
+        static const void *const executable = [] {
+            Dl_info self;
+            return dladdr((void *)&AllocTrace::allocations, &self) ? self.dli_fbase : nullptr;
+        }();
+        Dl_info info;
+        bool own = false;
+        if (dladdr(frame, &info) && info.dli_fbase == executable)
+        {
+            const char *name = info.dli_sname;
+            own = !name || !(std::strncmp(name, "_ZNSt", 5) == 0 || std::strncmp(name, "_ZNKSt", 6) == 0 ||
+                             std::strncmp(name, "_ZSt", 4) == 0 || std::strncmp(name, "_ZNSa", 5) == 0 ||
+                             std::strncmp(name, "_ZN9__gnu_cxx", 13) == 0 || std::strncmp(name, "_ZNK9__gnu_cxx", 14) == 0 ||
+                             std::strncmp(name, "_Znw", 4) == 0 || std::strncmp(name, "_Zna", 4) == 0);
+        }
+        if (slot)
+            slot->own.store(own ? 1 : 2, std::memory_order_release);
+        return own;
+#else
+        (void)frame;
+        return true;
+#endif
+    }
+
+    // 1.4 Allocation site : walk up from operator new to the first COMPY frame (Immediate caller when none found)
+    void *siteAddress()
+    {
+#ifndef _WIN32
+        void *stack[STACK_DEPTH];
+        const int depth = backtrace(stack, STACK_DEPTH);   // [0] this, [1] trackedAlloc, [2] operator new, ...
+        for (int i = 3; i < depth; ++i)
+        {
+            if (ownFrame(stack[i]))
+                return stack[i];
+        }
+        return depth > 3 ? stack[3] : nullptr;
+#else
+        return nullptr;
+#endif
+    }
+
+    // 1.5 Counted allocation (align = 0 : malloc alignment; block start rounded up after the header otherwise)
+    __attribute__((noinline)) void *trackedAlloc(size_t size, size_t align)
+    {
+        const size_t extra = HEADER + (align > HEADER ? align : 0);
+        if (size > (size_t)-1 - extra)
+            return nullptr;
+        void *raw = std::malloc(size + extra);
+        if (!raw)
+            return nullptr;
+
+        char *block = (char *)raw + HEADER;
+        if (align > HEADER)
+            block = (char *)(((size_t)block + align - 1) & ~(align - 1));
+        Header *h = (Header *)(block - HEADER);
+        h->size = size;
+        h->raw = raw;
+        h->phase = inHook ? -1 : currentPhase;
+
+        if (h->phase >= 0)
+        {
+            PhaseStats &p = phases[h->phase];
+            p.allocs.fetch_add(1, std::memory_order_relaxed);
+            p.bytes.fetch_add(size, std::memory_order_relaxed);
+            raisePeak(p.peak, p.live.fetch_add(size, std::memory_order_relaxed) + size);
+            raisePeak(statementPeak, liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+            statementAllocs.fetch_add(1, std::memory_order_relaxed);
+
+            inHook = true; // Unwinder / dladdr may allocate : not counted, no site lookup
+            void *site = siteAddress();
+            inHook = false;
+            if (SiteStats *s = site ? siteOf(site) : nullptr)
+            {
+                s->allocs.fetch_add(1, std::memory_order_relaxed);
+                s->bytes.fetch_add(size, std::memory_order_relaxed);
+            }
+        }
+        return block;
+    }
+
+    // 1.6 Counted free (Charged back to the phase that allocated it)
+    void trackedFree(void *ptr)
+    {
+        if (!ptr)
+            return;
+        Header *h = (Header *)((char *)ptr - HEADER);
+        if (h->phase >= 0)
+        {
+            PhaseStats &p = phases[h->phase];
+            p.frees.fetch_add(1, std::memory_order_relaxed);
+            p.live.fetch_sub(h->size, std::memory_order_relaxed);
+            liveBytes.fetch_sub(h->size, std::memory_order_relaxed);
+        }
+        std::free(h->raw);
+    }
+
+    // 1.7 Phase index of a name (Register on first use)
+    int phaseIndex(const char *name)
+    {
+        int n = phaseCount.load(std::memory_order_acquire);
+        for (int i = 1; i < n; ++i)
+        {
+            if (phases[i].name == name || std::strcmp(phases[i].name, name) == 0)
+                return i;
+        }
+
+        while (registerLock.test_and_set(std::memory_order_acquire))
+        {
+        }
+        n = phaseCount.load(std::memory_order_relaxed);
+        int index = 0; // Table full : charge to "other"
+        for (int i = 1; i < n && !index; ++i)
+        {
+            if (std::strcmp(phases[i].name, name) == 0)
+                index = i;
+        }
+        if (!index && n < MAX_PHASES)
+        {
+            phases[n].name = name;
+            phaseCount.store(n + 1, std::memory_order_release);
+            index = n;
+        }
+        registerLock.clear(std::memory_order_release);
+        return index;
+    }
+
+    // 1.8 Readable name of a site (Symbol when available : build with -rdynamic, else module + offset)
+    std::string siteName(void *site)
+    {
+#ifndef _WIN32
+        Dl_info info;
+        if (dladdr(site, &info) && info.dli_sname)
+        {
+            int status = 0;
+            char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            std::string name = (status == 0 && demangled) ? demangled : info.dli_sname;
+            std::free(demangled);
+            return name + " +" + std::to_string((char *)site - (char *)info.dli_saddr);
+        }
+        if (dladdr(site, &info) && info.dli_fname)
+        {
+            const char *file = std::strrchr(info.dli_fname, '/');
+            char offset[32];
+            std::snprintf(offset, sizeof(offset), " +0x%zx", (size_t)((char *)site - (char *)info.dli_fbase));
+            return std::string(file ? file + 1 : info.dli_fname) + offset;
+        }
+#endif
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%p", site);
+        return buf;
+    }
+}
+
+// 2. Replaceable global allocation functions (Plain, nothrow and over-aligned forms)
+void *operator new(std::size_t size)
+{
+    void *p = trackedAlloc(size, 0);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](std::size_t size)
+{
+    void *p = trackedAlloc(size, 0);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void *operator new(std::size_t size, std::align_val_t align)
+{
+    void *p = trackedAlloc(size, (size_t)align);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](std::size_t size, std::align_val_t align)
+{
+    void *p = trackedAlloc(size, (size_t)align);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return trackedAlloc(size, 0); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return trackedAlloc(size, 0); }
+void *operator new(std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept { return trackedAlloc(size, (size_t)align); }
+void *operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept { return trackedAlloc(size, (size_t)align); }
+
+void operator delete(void *p) noexcept { trackedFree(p); }
+void operator delete[](void *p) noexcept { trackedFree(p); }
+void operator delete(void *p, std::size_t) noexcept { trackedFree(p); }
+void operator delete[](void *p, std::size_t) noexcept { trackedFree(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { trackedFree(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { trackedFree(p); }
+void operator delete(void *p, std::align_val_t) noexcept { trackedFree(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { trackedFree(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { trackedFree(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { trackedFree(p); }
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept { trackedFree(p); }
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept { trackedFree(p); }
+
+// 3. Phase Scope
+AllocPhase::AllocPhase(const char *name) : previous(currentPhase)
+{
+    currentPhase = phaseIndex(name);
+}
+
+AllocPhase::~AllocPhase() { currentPhase = previous; }
+
+// 4. Statement boundary : reset counter, peak start again from what is still alive
+void AllocTrace::beginStatement()
+{
+    const int n = phaseCount.load(std::memory_order_acquire);
+    for (int i = 0; i < n; ++i)
+    {
+        phases[i].allocs.store(0, std::memory_order_relaxed);
+        phases[i].frees.store(0, std::memory_order_relaxed);
+        phases[i].bytes.store(0, std::memory_order_relaxed);
+        phases[i].peak.store(phases[i].live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    for (auto &s : sites)
+    {
+        s.allocs.store(0, std::memory_order_relaxed);
+        s.bytes.store(0, std::memory_order_relaxed);
+    }
+    statementAllocs.store(0, std::memory_order_relaxed);
+    statementPeak.store(liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+size_t AllocTrace::allocations() { return statementAllocs.load(std::memory_order_relaxed); }
+
+// 5. Print per-phase table + top allocation sites of the current statement
+void AllocTrace::report(size_t topSites)
+{
+    const bool wasInHook = inHook;
+    inHook = true;
+
+    std::cout << "\n-----------------------------------------------------------\n";
+    std::cout << "                   Allocation Report\n";
+    std::cout << "-----------------------------------------------------------\n";
+    std::cout << std::left
+              << std::setw(12) << "Phase"
+              << std::setw(10) << "Allocs"
+              << std::setw(10) << "Frees"
+              << std::setw(14) << "Bytes"
+              << std::setw(14) << "Peak Live" << "\n";
+    std::cout << "-----------------------------------------------------------\n";
+
+    const int n = phaseCount.load(std::memory_order_acquire);
+    for (int i = 0; i < n; ++i)
+    {
+        const PhaseStats &p = phases[i];
+        if (p.allocs.load() == 0 && p.frees.load() == 0)
+            continue; // Only print phase that did something
+        std::cout << std::left
+                  << std::setw(12) << (i == 0 ? "other" : p.name)
+                  << std::setw(10) << p.allocs.load()
+                  << std::setw(10) << p.frees.load()
+                  << std::setw(14) << p.bytes.load()
+                  << std::setw(14) << p.peak.load() << "\n";
+    }
+    std::cout << "Statement: " << statementAllocs.load() << " allocations, peak live " << statementPeak.load() << " bytes\n";
+
+    // Top sites by byte
+    size_t order[MAX_SITES];
+    size_t used = 0;
+    for (size_t i = 0; i < MAX_SITES; ++i)
+    {
+        if (sites[i].allocs.load(std::memory_order_relaxed))
+            order[used++] = i;
+    }
+    const size_t shown = std::min(topSites, used);
+    std::partial_sort(order, order + shown, order + used, [](size_t a, size_t b) { return sites[a].bytes.load() > sites[b].bytes.load(); });
+
+    if (shown)
+        std::cout << "Top allocation sites:\n";
+    for (size_t i = 0; i < shown; ++i)
+    {
+        const SiteStats &s = sites[order[i]];
+        std::cout << "  " << std::setw(10) << s.bytes.load() << " bytes " << std::setw(6) << s.allocs.load()
+                  << " allocs  " << siteName(s.site.load()) << "\n";
+    }
+    std::cout << "-----------------------------------------------------------\n";
+
+    inHook = wasInHook;
+}
+
+#endif
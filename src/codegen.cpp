@@ -0,0 +1,286 @@
+#include "../include/codegen.hpp"   // Reference to Class header
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <dlfcn.h>
+#include <spawn.h>
+#include <sys/wait.h>
+extern char **environ;
+#endif
+
+// 1. Construct new Code Generator
+CodeGen::CodeGen(const std::vector<const Parser::Node *> &stmts) : statements(stmts), tempCount(0), slots(Evaluator::VARIABLE_COUNT) {}
+
+// 2. Emit whole translation unit (Prelude + compy_run)
+std::string CodeGen::emit()
+{
+    body.clear();
+    tempCount = 0;
+    slots = Evaluator::VARIABLE_COUNT;
+
+    // A. One block per statement, assignment at the end
+    for (size_t i = 0; i < statements.size(); ++i)
+    {
+        const Parser::Node *stmt = statements[i];
+        body += "\n    // statement " + std::to_string(i + 1) + " : " + stmt->left->value + " = ...\n    {\n";
+        std::string value = emitExpr(stmt->right, i + 1);
+        body += "        v[" + std::to_string(variableSlot(stmt->left)) + "] = " + value + ";\n    }\n";
+        slots = std::max(slots, variableSlot(stmt->left) + 1);
+    }
+
+    // B. Prelude (Same wrap around / checked division rules as compy_arith)
+    std::ostringstream out;
+    out << "// Generated by COMPY CodeGen (do not edit)\n"
+        << "// Variable array : " << slots << " values (index by symbol id)\n\n"
+        << "static inline long long compy_add(long long a, long long b) { return (long long)((unsigned long long)a + (unsigned long long)b); }\n"
+        << "static inline long long compy_sub(long long a, long long b) { return (long long)((unsigned long long)a - (unsigned long long)b); }\n"
+        << "static inline long long compy_mul(long long a, long long b) { return (long long)((unsigned long long)a * (unsigned long long)b); }\n"
+        << "static inline bool compy_div(long long a, long long b, long long *out)\n"
+        << "{\n"
+        << "    if (b == 0)\n"
+        << "        return false;\n"
+        << "    *out = (b == -1) ? compy_sub(0, a) : a / b;\n"
+        << "    return true;\n"
+        << "}\n"
+        << "static inline bool compy_mod(long long a, long long b, long long *out)\n"
+        << "{\n"
+        << "    if (b == 0)\n"
+        << "        return false;\n"
+        << "    *out = (b == -1) ? 0 : a % b;\n"
+        << "    return true;\n"
+        << "}\n"
+        << "static inline bool compy_pow(long long a, long long b, long long *out)\n"
+        << "{\n"
+        << "    if (b < 0)\n"
+        << "    {\n"
+        << "        if (a == 0)\n"
+        << "            return false;\n"
+        << "        *out = (a == 1) ? 1 : (a == -1) ? ((b & 1) ? -1 : 1) : 0;\n"
+        << "        return true;\n"
+        << "    }\n"
+        << "    long long r = 1;\n"
+        << "    for (; b > 0; b >>= 1)\n"
+        << "    {\n"
+        << "        if (b & 1)\n"
+        << "            r = compy_mul(r, a);\n"
+        << "        a = compy_mul(a, a);\n"
+        << "    }\n"
+        << "    *out = r;\n"
+        << "    return true;\n"
+        << "}\n\n"
+        << "extern \"C\"\n"
+        << "#ifdef _WIN32\n"
+        << "__declspec(dllexport)\n"
+        << "#endif\n"
+        << "int compy_run(long long *v)\n"
+        << "{\n"
+        << body
+        << "    return 0;\n"
+        << "}\n";
+    return out.str();
+}
+
+// 3. Emit expression (Post-order on an explicit stack : chain of any length) : Operands become temporaries,
+//    division return statement number on zero
+std::string CodeGen::emitExpr(const Parser::Node *root, size_t stmtNo)
+{
+    struct Frame
+    {
+        const Parser::Node *node;
+        bool expanded;                          // Children already pushed (Their operands are on top of operands)
+    };
+    std::vector<Frame> work{{root, false}};
+    std::vector<std::string> operands;          // C++ operand of every finished child, left before right
+
+    while (!work.empty())
+    {
+        const Frame frame = work.back();
+        work.pop_back();
+        const Parser::Node *node = frame.node;
+
+        // A. Leaves
+        if (node->type == TokenType::NUMBER)
+        {
+            operands.push_back("(long long)" + std::to_string((unsigned long long)compy_arith::parseLiteral(node->value)) + "ULL");
+            continue;
+        }
+        if (node->type == TokenType::IDENTIFIER)
+        {
+            slots = std::max(slots, variableSlot(node) + 1);
+            operands.push_back("v[" + std::to_string(variableSlot(node)) + "]");
+            continue;
+        }
+
+        // B. Operator : children first (Right pushed first so left is emitted first)
+        if (!frame.expanded)
+        {
+            work.push_back({node, true});
+            work.push_back({node->right, false});
+            if (node->left)
+                work.push_back({node->left, false});
+            continue;
+        }
+
+        std::string r = std::move(operands.back());
+        operands.pop_back();
+        std::string t = "t" + std::to_string(tempCount++);
+
+        // B.1 Unary minus (Left child empty)
+        if (!node->left)
+        {
+            if (node->proven)
+                body += "        long long " + t + " = -" + r + ";\n";
+            else
+                body += "        long long " + t + " = compy_sub(0, " + r + ");\n";
+            operands.push_back(t);
+            continue;
+        }
+
+        std::string l = std::move(operands.back());
+        operands.pop_back();
+
+        // B.2 Proven by RangeAnalysis : plain native operation, no wrap / zero check needed
+        if (node->proven)
+        {
+            body += "        long long " + t + " = " + l + " " + node->value + " " + r + ";\n";
+            operands.push_back(t);
+            continue;
+        }
+
+        switch (node->value[0])
+        {
+        case '+':
+            body += "        long long " + t + " = compy_add(" + l + ", " + r + ");\n";
+            break;
+        case '-':
+            body += "        long long " + t + " = compy_sub(" + l + ", " + r + ");\n";
+            break;
+        case '*':
+            body += "        long long " + t + " = compy_mul(" + l + ", " + r + ");\n";
+            break;
+        default: // '/' '%' '^' : checked, return statement number on division by zero
+        {
+            const char *name = node->value[0] == '/' ? "compy_div" : node->value[0] == '%' ? "compy_mod" : "compy_pow";
+            body += "        long long " + t + ";\n";
+            body += "        if (!" + std::string(name) + "(" + l + ", " + r + ", &" + t + "))\n";
+            body += "            return " + std::to_string(stmtNo) + ";\n";
+            break;
+        }
+        }
+        operands.push_back(t);
+    }
+    return operands.back();
+}
+
+// 4. Construct empty Native Program
+NativeProgram::NativeProgram() : handle(nullptr), entry(nullptr) {}
+
+NativeProgram::~NativeProgram() { unload(); }
+
+// 4.1 Release loaded shared object
+void NativeProgram::unload()
+{
+    if (handle)
+    {
+#ifdef _WIN32
+        FreeLibrary((HMODULE)handle);
+#else
+        dlclose(handle);
+#endif
+    }
+    handle = nullptr;
+    entry = nullptr;
+}
+
+// 4.2 Run g++ on one source file : true when it exit with 0
+bool NativeProgram::compile(const std::string &sourcePath, const std::string &libPath)
+{
+#ifdef _WIN32
+    const std::string quotedLib = "\"" + libPath + "\"", quotedSource = "\"" + sourcePath + "\""; // _spawnvp join argv with spaces
+    const char *args[] = {"g++", "-O2", "-shared", "-o", quotedLib.c_str(), quotedSource.c_str(), nullptr};
+    const intptr_t status = _spawnvp(_P_WAIT, "g++", args);
+    if (status != 0)
+    {
+        error = status < 0 ? "cannot start g++" : "compiler failed on '" + sourcePath + "'";
+        return false;
+    }
+#else
+    const char *args[] = {"g++", "-O2", "-shared", "-fPIC", "-o", libPath.c_str(), sourcePath.c_str(), nullptr};
+    pid_t pid = 0;
+    if (posix_spawnp(&pid, "g++", nullptr, nullptr, const_cast<char *const *>(args), environ) != 0)
+    {
+        error = "cannot start g++";
+        return false;
+    }
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0)
+    {
+        if (errno != EINTR)
+        {
+            error = "cannot wait for g++";
+            return false;
+        }
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+        error = "compiler failed on '" + sourcePath + "'";
+        return false;
+    }
+#endif
+    return true;
+}
+
+// 4.3 Write source, compile with g++ into shared object, then load compy_run
+bool NativeProgram::build(const std::string &source, const std::string &basePath)
+{
+    unload();
+    error.clear();
+
+#ifdef _WIN32
+    const std::string libPath = basePath + ".dll";
+#else
+    const std::string libPath = basePath + ".so";
+#endif
+    const std::string sourcePath = basePath + ".cpp";
+
+    // A. Write translation unit
+    {
+        std::ofstream file(basePath + ".cpp");
+        if (!file)
+        {
+            error = "cannot write '" + basePath + ".cpp'";
+            return false;
+        }
+        file << source;
+    }
+
+    // B. Compile (Paths go to g++ as separate arguments : no shell, nothing in a path is interpreted)
+    if (!compile(sourcePath, libPath))
+        return false;
+
+    // C. Load + find entry point
+#ifdef _WIN32
+    handle = (void *)LoadLibraryA(libPath.c_str());
+    if (handle)
+        entry = (CompyEntry)GetProcAddress((HMODULE)handle, "compy_run");
+#else
+    handle = dlopen(libPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (handle)
+        entry = (CompyEntry)dlsym(handle, "compy_run");
+#endif
+
+    if (!entry)
+    {
+        error = "cannot load compy_run from '" + libPath + "'";
+        unload();
+        return false;
+    }
+    return true;
+}
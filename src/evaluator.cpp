@@ -0,0 +1,178 @@
+#include "../include/evaluator.hpp"     // Reference to Class header
+#include "../include/state_store.hpp"
+#include <iostream>
+
+// 1. Decimal literal to 64-bit value (Lexer accept any run of digits, so wrap around like the arithmetic)
+long long compy_arith::parseLiteral(const std::string &digits)
+{
+    unsigned long long value = 0;
+    for (char c : digits)
+        value = value * 10 + (unsigned long long)(c - '0');
+    return (long long)value;
+}
+
+// 2. Constructor Evaluator (Initialize every variable to 0)
+Evaluator::Evaluator() : vars(VARIABLE_COUNT, 0) {}
+
+// 3. Execute one assignment [ id = <expr> ; ]
+bool Evaluator::execute(const Parser::Node *stmt)
+{
+    if (!stmt || stmt->type != TokenType::ASSIGNMENT || !stmt->left || stmt->left->type != TokenType::IDENTIFIER)
+    {
+        runtimeErrors.push_back("RuntimeError: statement is not a valid assignment.");
+        return false;
+    }
+
+    long long value = 0;
+    if (!evaluate(stmt->right, value))
+        return false;
+
+    set(variableSlot(stmt->left), value);
+    return true;
+}
+
+// 3.1 Write variable (Flat array index by symbol id, grown on first write of a new name)
+void Evaluator::set(size_t slot, long long value)
+{
+    if (versioned)
+        versioned->set(slot, value);
+    else
+    {
+        if (slot >= vars.size())
+            vars.resize(slot + 1, 0);
+        vars[slot] = value;
+    }
+    if (journal)
+        journal->append(slot, value);
+}
+
+// 3.2 Execute statements in order (Stop at first runtime error, same as generated code)
+bool Evaluator::run(const std::vector<const Parser::Node *> &stmts)
+{
+    for (const auto *stmt : stmts)
+    {
+        if (!execute(stmt))
+            return false;
+    }
+    return true;
+}
+
+// 4. Evaluate expression tree (Post-order : children first, explicit stack so a 200k-term chain cannot overflow the call stack)
+bool Evaluator::evaluate(const Parser::Node *root, long long &out)
+{
+    struct Frame
+    {
+        const Parser::Node *node;
+        bool expanded;                          // Children already pushed (Their values are on top of values)
+    };
+    std::vector<Frame> work{{root, false}};
+    std::vector<long long> values;              // Value of every finished child, left before right
+
+    while (!work.empty())
+    {
+        const Frame frame = work.back();
+        work.pop_back();
+        const Parser::Node *node = frame.node;
+        if (!node)
+        {
+            runtimeErrors.push_back("RuntimeError: missing operand.");
+            return false;
+        }
+
+        // A. Leaves
+        if (node->type == TokenType::NUMBER)
+        {
+            values.push_back(compy_arith::parseLiteral(node->value));
+            continue;
+        }
+        if (node->type == TokenType::IDENTIFIER)
+        {
+            values.push_back(get(variableSlot(node)));
+            continue;
+        }
+        if (node->type != TokenType::OPERATOR)
+        {
+            runtimeErrors.push_back("RuntimeError: cannot evaluate '" + node->value + "'.");
+            return false;
+        }
+
+        // B. Operator : children first (Right pushed first so left is evaluated first, same error order as before)
+        const bool unary = !node->left && node->value[0] == '-';
+        if (!frame.expanded)
+        {
+            work.push_back({node, true});
+            work.push_back({node->right, false});
+            if (!unary)
+                work.push_back({node->left, false});
+            continue;
+        }
+
+        const long long r = values.back();
+        values.pop_back();
+        long long value = 0;
+        if (unary)
+            value = compy_arith::sub(0, r); // Unary minus (LLONG_MIN wrap to itself)
+        else
+        {
+            const long long l = values.back();
+            values.pop_back();
+            if (!apply(node, l, r, value))
+                return false;
+        }
+        values.push_back(value);
+    }
+    out = values.back();
+    return true;
+}
+
+// 4.1 One binary operation on evaluated operands
+bool Evaluator::apply(const Parser::Node *node, long long l, long long r, long long &out)
+{
+    switch (node->value[0])
+    {
+    case '+': out = compy_arith::add(l, r); return true;
+    case '-': out = compy_arith::sub(l, r); return true;
+    case '*': out = compy_arith::mul(l, r); return true;
+    case '/':
+        if (node->proven) // RangeAnalysis proved divisor non-zero and no overflow
+        {
+            out = l / r;
+            return true;
+        }
+        if (!compy_arith::div(l, r, out))
+        {
+            runtimeErrors.push_back("RuntimeError: division by zero.");
+            return false;
+        }
+        return true;
+    case '%':
+        if (node->proven)
+        {
+            out = l % r;
+            return true;
+        }
+        if (!compy_arith::mod(l, r, out))
+        {
+            runtimeErrors.push_back("RuntimeError: division by zero.");
+            return false;
+        }
+        return true;
+    case '^':
+        if (!compy_arith::pow(l, r, out))
+        {
+            runtimeErrors.push_back("RuntimeError: division by zero.");
+            return false;
+        }
+        return true;
+    }
+
+    runtimeErrors.push_back("RuntimeError: cannot evaluate '" + node->value + "'.");
+    return false;
+}
+
+// 5. Print collected runtime error
+void Evaluator::printErrors() const
+{
+    for (const auto &err : runtimeErrors)
+        std::cerr << err << std::endl;
+}
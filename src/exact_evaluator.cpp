@@ -0,0 +1,155 @@
+#include "../include/exact_evaluator.hpp"     // Reference to Class header
+#include <iostream>
+
+// 1. Constructor ExactEvaluator (Initialize every variable to 0)
+ExactEvaluator::ExactEvaluator() : vars(Evaluator::VARIABLE_COUNT) {}
+
+// 2. Execute one assignment [ id = <expr> ; ]
+bool ExactEvaluator::execute(const Parser::Node *stmt)
+{
+    if (!stmt || stmt->type != TokenType::ASSIGNMENT || !stmt->left || stmt->left->type != TokenType::IDENTIFIER)
+    {
+        runtimeErrors.push_back("RuntimeError: statement is not a valid assignment.");
+        return false;
+    }
+
+    Integer value;
+    if (!evaluate(stmt->right, value))
+        return false;
+
+    set(variableSlot(stmt->left), value);
+    return true;
+}
+
+// 2.1 Write variable (Grown on first write of a new name)
+void ExactEvaluator::set(size_t slot, const Integer &value)
+{
+    if (slot >= vars.size())
+        vars.resize(slot + 1);
+    vars[slot] = value;
+}
+
+// 2.2 Execute statements in order (Stop at first runtime error)
+bool ExactEvaluator::run(const std::vector<const Parser::Node *> &stmts)
+{
+    for (const auto *stmt : stmts)
+    {
+        if (!execute(stmt))
+            return false;
+    }
+    return true;
+}
+
+// 3. Evaluate expression tree (Post-order : children first, explicit stack so a 200k-term chain cannot overflow the call stack)
+bool ExactEvaluator::evaluate(const Parser::Node *root, Integer &out)
+{
+    struct Frame
+    {
+        const Parser::Node *node;
+        bool expanded;                          // Children already pushed (Their values are on top of values)
+    };
+    std::vector<Frame> work{{root, false}};
+    std::vector<Integer> values;                // Value of every finished child, left before right
+
+    while (!work.empty())
+    {
+        const Frame frame = work.back();
+        work.pop_back();
+        const Parser::Node *node = frame.node;
+        if (!node)
+        {
+            runtimeErrors.push_back("RuntimeError: missing operand.");
+            return false;
+        }
+
+        // A. Leaves
+        if (node->type == TokenType::NUMBER)
+        {
+            Integer v;
+            if (!check(Integer::fromLiteral(node->value, v)))
+                return false;
+            values.push_back(v);
+            continue;
+        }
+        if (node->type == TokenType::IDENTIFIER)
+        {
+            values.push_back(get(variableSlot(node)));
+            continue;
+        }
+        if (node->type != TokenType::OPERATOR)
+        {
+            runtimeErrors.push_back("RuntimeError: cannot evaluate '" + node->value + "'.");
+            return false;
+        }
+
+        // B. Operator : children first (Right pushed first so left is evaluated first)
+        const bool unary = !node->left && node->value[0] == '-';
+        if (!frame.expanded)
+        {
+            work.push_back({node, true});
+            work.push_back({node->right, false});
+            if (!unary)
+                work.push_back({node->left, false});
+            continue;
+        }
+
+        const Integer r = values.back();
+        values.pop_back();
+        Integer value;
+        if (unary)
+        {
+            if (!check(Integer::negate(r, value)))
+                return false;
+        }
+        else
+        {
+            const Integer l = values.back();
+            values.pop_back();
+            if (!apply(node->value[0], l, r, value))
+                return false;
+        }
+        values.push_back(value);
+    }
+    out = values.back();
+    return true;
+}
+
+// 3.1 One binary operation on evaluated operands
+bool ExactEvaluator::apply(char op, const Integer &l, const Integer &r, Integer &out)
+{
+    switch (op)
+    {
+    case '+': return check(Integer::add(l, r, out));
+    case '-': return check(Integer::sub(l, r, out));
+    case '*': return check(Integer::mul(l, r, out));
+    case '/': return check(Integer::div(l, r, out));
+    case '%': return check(Integer::mod(l, r, out));
+    case '^': return check(Integer::pow(l, r, out));
+    }
+    runtimeErrors.push_back(std::string("RuntimeError: cannot evaluate '") + op + "'.");
+    return false;
+}
+
+// 3.2 Operation error to runtime error message
+bool ExactEvaluator::fail(ArithError err)
+{
+    switch (err)
+    {
+    case ArithError::NONE:
+        break;
+    case ArithError::DIVISION_BY_ZERO:
+        runtimeErrors.push_back("RuntimeError: division by zero.");
+        return false;
+    case ArithError::TOO_LARGE:
+        runtimeErrors.push_back("RuntimeError: integer result is larger than " + std::to_string(Integer::MAX_BITS) + " bits.");
+        return false;
+    }
+    return false;
+}
+
+// 4. Print collected runtime error
+void ExactEvaluator::printErrors() const
+{
+    for (const auto &err : runtimeErrors)
+        std::cerr << err << std::endl;
+}
@@ -0,0 +1,230 @@
+#include "../include/exporter.hpp"  // Reference to Class header
+#include "../include/source_index.hpp"   // UTF-8 decoding
+
+// 1. Name of Token Type (Same spelling as enum)
+static const char *tokenTypeName(TokenType type)
+{
+    switch (type)
+    {
+    case TokenType::IDENTIFIER:           return "IDENTIFIER";
+    case TokenType::NUMBER:               return "NUMBER";
+    case TokenType::OPERATOR:             return "OPERATOR";
+    case TokenType::ASSIGNMENT:           return "ASSIGNMENT";
+    case TokenType::LEFT_PAREN:           return "LEFT_PAREN";
+    case TokenType::RIGHT_PAREN:          return "RIGHT_PAREN";
+    case TokenType::STATEMENT_TERMINATOR: return "STATEMENT_TERMINATOR";
+    default:                              return "INVALID";
+    }
+}
+
+// 2. Construct Exporter (Reserve buffer once)
+TreeExporter::TreeExporter(std::ostream &os, size_t bufferSize) : out(os), capacity(bufferSize)
+{
+    buffer.reserve(capacity);
+}
+
+TreeExporter::~TreeExporter() { flush(); }
+
+// 2.1 Push buffer to stream (Buffer keep its capacity for the next write)
+void TreeExporter::flush()
+{
+    if (!buffer.empty())
+    {
+        out.write(buffer.data(), (std::streamsize)buffer.size());
+        buffer.clear();
+    }
+}
+
+// 2.2 Append helpers
+void TreeExporter::put(char c)
+{
+    buffer.push_back(c);
+    if (buffer.size() >= capacity)
+        flush();
+}
+
+void TreeExporter::put(const std::string &s)
+{
+    buffer.append(s);
+    if (buffer.size() >= capacity)
+        flush();
+}
+
+void TreeExporter::putNumber(size_t n)
+{
+    char digits[24];
+    int len = 0;
+    do
+    {
+        digits[len++] = (char)('0' + n % 10);
+        n /= 10;
+    } while (n);
+    while (len)
+        put(digits[--len]);
+}
+
+// 2.3 Quoted string : escape '"' '\' and control character, malformed UTF-8 byte become U+FFFD (Valid for both JSON and DOT)
+void TreeExporter::putQuoted(const std::string &s)
+{
+    static const char hex[] = "0123456789abcdef";
+    put('"');
+    for (size_t i = 0; i < s.size();)
+    {
+        const unsigned char c = (unsigned char)s[i];
+        if (c >= 0x80)
+        {
+            bool valid = false;
+            const size_t len = utf8::decode(s.data(), s.size(), i, valid);
+            if (valid)
+            {
+                for (size_t k = 0; k < len; ++k)
+                    put(s[i + k]);
+            }
+            else
+                put("\xEF\xBF\xBD"); // Replacement character, one per bad byte
+            i += valid ? len : 1;
+            continue;
+        }
+        if (c == '"' || c == '\\')
+        {
+            put('\\');
+            put((char)c);
+        }
+        else if (c < 0x20)
+        {
+            put("\\u00");
+            put(hex[c >> 4]);
+            put(hex[c & 0xF]);
+        }
+        else
+            put((char)c);
+        ++i;
+    }
+    put('"');
+}
+
+// 3. JSON : token stream + tree (null child omitted)
+void TreeExporter::writeJson(const std::vector<Token> &tokens, const Parser::Node *root)
+{
+    put("{\"tokens\":[");
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+        if (i)
+            put(',');
+        put("{\"type\":\"");
+        put(tokenTypeName(tokens[i].type));
+        put("\",\"value\":");
+        putQuoted(tokens[i].value);
+        put(",\"pos\":");
+        putNumber(tokens[i].start_pos);
+        put('}');
+    }
+    put("],\"tree\":");
+    if (root)
+        walk(root, Format::JSON);
+    else
+        put("null");
+    put("}\n");
+}
+
+// 4. S-expression : leaf as atom, operator as (op left right)
+void TreeExporter::writeSExpr(const Parser::Node *root)
+{
+    if (root)
+        walk(root, Format::SEXPR);
+    else
+        put("()");
+    put('\n');
+}
+
+// 5. Graphviz DOT : one vertex per Node, edge from parent to child
+void TreeExporter::writeDot(const Parser::Node *root)
+{
+    put("digraph AST {\n  node [shape=box];\n");
+    if (root)
+        walk(root, Format::DOT);
+    put("}\n");
+}
+
+// 6. Iterative walk : each Node entered once and left once (Linear time, no recursion)
+void TreeExporter::walk(const Parser::Node *root, Format format)
+{
+    size_t nextId = 0;
+    stack.clear();
+    stack.push_back(Frame{root, nextId++, 0});
+
+    while (!stack.empty())
+    {
+        Frame &f = stack.back();
+        const Parser::Node *n = f.node;
+        const bool leaf = !n->left && !n->right;
+
+        // A. Enter Node
+        if (f.stage == 0)
+        {
+            f.stage = 1;
+            switch (format)
+            {
+            case Format::JSON:
+                put("{\"value\":");
+                putQuoted(n->value);
+                put(",\"type\":\"");
+                put(tokenTypeName(n->type));
+                put('"');
+                break;
+            case Format::SEXPR:
+                if (!leaf)
+                    put('(');
+                put(n->value);
+                break;
+            case Format::DOT:
+                put("  n");
+                putNumber(f.id);
+                put(" [label=");
+                putQuoted(n->value);
+                put("];\n");
+                if (stack.size() > 1)
+                {
+                    put("  n");
+                    putNumber(stack[stack.size() - 2].id);
+                    put(" -> n");
+                    putNumber(f.id);
+                    put(";\n");
+                }
+                break;
+            }
+
+            if (n->left)
+            {
+                if (format == Format::JSON)
+                    put(",\"left\":");
+                else if (format == Format::SEXPR)
+                    put(' ');
+                stack.push_back(Frame{n->left, nextId++, 0}); // f may dangle after push
+            }
+            continue;
+        }
+
+        // B. Left subtree done, go right
+        if (f.stage == 1)
+        {
+            f.stage = 2;
+            if (n->right)
+            {
+                if (format == Format::JSON)
+                    put(",\"right\":");
+                else if (format == Format::SEXPR)
+                    put(' ');
+                stack.push_back(Frame{n->right, nextId++, 0});
+            }
+            continue;
+        }
+
+        // C. Leave Node
+        if (format == Format::JSON)
+            put('}');
+        else if (format == Format::SEXPR && !leaf)
+            put(')');
+        stack.pop_back();
+    }
+}
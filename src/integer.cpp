@@ -0,0 +1,423 @@
+#include "../include/integer.hpp"  // Reference to Class header
+#include <algorithm>
+#include <climits>
+
+// 1. BigInt from int64 (|LLONG_MIN| = 2^63 is done in unsigned)
+BigInt::BigInt(long long value) : negative(value < 0)
+{
+    unsigned long long m = negative ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    while (m)
+    {
+        limbs.push_back((uint32_t)m);
+        m >>= 32;
+    }
+}
+
+// 1.1 Decimal literal (9 digits at a time : magnitude = magnitude * 10^9 + chunk)
+BigInt BigInt::fromDecimal(const std::string &digits)
+{
+    BigInt result;
+    size_t i = 0;
+    while (i < digits.size())
+    {
+        const size_t take = std::min<size_t>(9, digits.size() - i);
+        uint64_t chunk = 0, scale = 1;
+        for (size_t k = 0; k < take; ++k, ++i)
+        {
+            chunk = chunk * 10 + (uint64_t)(digits[i] - '0');
+            scale *= 10;
+        }
+
+        uint64_t carry = chunk;
+        for (auto &limb : result.limbs)
+        {
+            const uint64_t t = (uint64_t)limb * scale + carry;
+            limb = (uint32_t)t;
+            carry = t >> 32;
+        }
+        if (carry)
+            result.limbs.push_back((uint32_t)carry);
+    }
+    result.trim();
+    return result;
+}
+
+// 1.2 Decimal text (Divide a copy by 10^9 until zero, chunks come out least significant first)
+std::string BigInt::toString() const
+{
+    if (limbs.empty())
+        return "0";
+
+    std::vector<uint32_t> m = limbs;
+    std::vector<uint32_t> chunks;
+    while (!m.empty())
+    {
+        uint64_t rem = 0;
+        for (size_t i = m.size(); i-- > 0;)
+        {
+            const uint64_t cur = (rem << 32) | m[i];
+            m[i] = (uint32_t)(cur / 1000000000u);
+            rem = cur % 1000000000u;
+        }
+        chunks.push_back((uint32_t)rem);
+        while (!m.empty() && m.back() == 0)
+            m.pop_back();
+    }
+
+    std::string text = negative ? "-" : "";
+    text += std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;)
+    {
+        const std::string part = std::to_string(chunks[i]);
+        text += std::string(9 - part.size(), '0') + part;
+    }
+    return text;
+}
+
+// 1.3 Fit int64 ? (Range is [-2^63, 2^63 - 1])
+bool BigInt::toInt64(long long &out) const
+{
+    if (limbs.size() > 2)
+        return false;
+    uint64_t m = 0;
+    for (size_t i = limbs.size(); i-- > 0;)
+        m = (m << 32) | limbs[i];
+    if (negative ? m > (uint64_t)LLONG_MAX + 1 : m > (uint64_t)LLONG_MAX)
+        return false;
+    out = negative ? (long long)(0ULL - m) : (long long)m;
+    return true;
+}
+
+size_t BigInt::bitLength() const
+{
+    if (limbs.empty())
+        return 0;
+    return (limbs.size() - 1) * 32 + (32 - (size_t)__builtin_clz(limbs.back()));
+}
+
+void BigInt::trim()
+{
+    while (!limbs.empty() && limbs.back() == 0)
+        limbs.pop_back();
+    if (limbs.empty())
+        negative = false;
+}
+
+BigInt BigInt::negated() const
+{
+    BigInt r = *this;
+    r.negative = !negative && !limbs.empty();
+    return r;
+}
+
+// 2. Magnitude helpers
+int BigInt::compareMagnitude(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b)
+{
+    if (a.size() != b.size())
+        return a.size() < b.size() ? -1 : 1;
+    for (size_t i = a.size(); i-- > 0;)
+    {
+        if (a[i] != b[i])
+            return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+std::vector<uint32_t> BigInt::addMagnitude(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b)
+{
+    const std::vector<uint32_t> &lo = a.size() < b.size() ? a : b;
+    const std::vector<uint32_t> &hi = a.size() < b.size() ? b : a;
+    std::vector<uint32_t> r(hi.size() + 1);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < hi.size(); ++i)
+    {
+        const uint64_t t = (uint64_t)hi[i] + (i < lo.size() ? lo[i] : 0) + carry;
+        r[i] = (uint32_t)t;
+        carry = t >> 32;
+    }
+    r[hi.size()] = (uint32_t)carry;
+    return r;
+}
+
+std::vector<uint32_t> BigInt::subMagnitude(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b)
+{
+    std::vector<uint32_t> r(a.size());
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        int64_t t = (int64_t)a[i] - (i < b.size() ? b[i] : 0) - borrow;
+        borrow = t < 0;
+        r[i] = (uint32_t)(t + (borrow << 32));
+    }
+    return r;
+}
+
+// 2.1 Long division of magnitudes (Knuth algorithm D, normalized so the top divisor limb has its high bit set)
+void BigInt::divideMagnitude(const std::vector<uint32_t> &u, const std::vector<uint32_t> &v, std::vector<uint32_t> &q, std::vector<uint32_t> &r)
+{
+    const size_t n = v.size();
+    if (compareMagnitude(u, v) < 0)
+    {
+        q.clear();
+        r = u;
+        return;
+    }
+
+    // A. One limb divisor : simple short division
+    if (n == 1)
+    {
+        q.assign(u.size(), 0);
+        uint64_t rem = 0;
+        for (size_t i = u.size(); i-- > 0;)
+        {
+            const uint64_t cur = (rem << 32) | u[i];
+            q[i] = (uint32_t)(cur / v[0]);
+            rem = cur % v[0];
+        }
+        r.assign(1, (uint32_t)rem);
+        return;
+    }
+
+    // B. Normalize
+    const size_t m = u.size() - n;
+    const int s = __builtin_clz(v.back());
+    std::vector<uint32_t> vn(n), un(u.size() + 1);
+    for (size_t i = n - 1; i > 0; --i)
+        vn[i] = (v[i] << s) | (s ? (uint32_t)((uint64_t)v[i - 1] >> (32 - s)) : 0);
+    vn[0] = v[0] << s;
+    un[u.size()] = s ? (uint32_t)((uint64_t)u.back() >> (32 - s)) : 0;
+    for (size_t i = u.size() - 1; i > 0; --i)
+        un[i] = (u[i] << s) | (s ? (uint32_t)((uint64_t)u[i - 1] >> (32 - s)) : 0);
+    un[0] = u[0] << s;
+
+    // C. One quotient limb per step : estimate from the top two limbs, correct at most twice
+    const uint64_t base = 1ULL << 32;
+    q.assign(m + 1, 0);
+    for (size_t j = m + 1; j-- > 0;)
+    {
+        const uint64_t num = ((uint64_t)un[j + n] << 32) | un[j + n - 1];
+        uint64_t qhat = num / vn[n - 1];
+        uint64_t rhat = num % vn[n - 1];
+        while (qhat >= base || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2]))
+        {
+            --qhat;
+            rhat += vn[n - 1];
+            if (rhat >= base)
+                break;
+        }
+
+        // Multiply and subtract
+        int64_t k = 0, t = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const uint64_t p = qhat * vn[i];
+            t = (int64_t)un[i + j] - k - (int64_t)(p & 0xFFFFFFFFULL);
+            un[i + j] = (uint32_t)t;
+            k = (int64_t)(p >> 32) - (t >> 32);
+        }
+        t = (int64_t)un[j + n] - k;
+        un[j + n] = (uint32_t)t;
+
+        // Subtracted too much : add one divisor back
+        q[j] = (uint32_t)qhat;
+        if (t < 0)
+        {
+            --q[j];
+            uint64_t carry = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                const uint64_t sum = (uint64_t)un[i + j] + vn[i] + carry;
+                un[i + j] = (uint32_t)sum;
+                carry = sum >> 32;
+            }
+            un[j + n] += (uint32_t)carry;
+        }
+    }
+
+    // D. Remainder = un >> s
+    r.assign(n, 0);
+    for (size_t i = 0; i < n; ++i)
+        r[i] = (un[i] >> s) | (s ? (uint32_t)((uint64_t)un[i + 1] << (32 - s)) : 0);
+}
+
+// 3. Signed operations
+BigInt BigInt::add(const BigInt &a, const BigInt &b)
+{
+    BigInt r;
+    if (a.negative == b.negative)
+    {
+        r.limbs = addMagnitude(a.limbs, b.limbs);
+        r.negative = a.negative;
+    }
+    else if (compareMagnitude(a.limbs, b.limbs) >= 0)
+    {
+        r.limbs = subMagnitude(a.limbs, b.limbs);
+        r.negative = a.negative;
+    }
+    else
+    {
+        r.limbs = subMagnitude(b.limbs, a.limbs);
+        r.negative = b.negative;
+    }
+    r.trim();
+    return r;
+}
+
+BigInt BigInt::sub(const BigInt &a, const BigInt &b) { return add(a, b.negated()); }
+
+BigInt BigInt::mul(const BigInt &a, const BigInt &b)
+{
+    BigInt r;
+    if (a.isZero() || b.isZero())
+        return r;
+    r.limbs.assign(a.limbs.size() + b.limbs.size(), 0);
+    for (size_t i = 0; i < a.limbs.size(); ++i)
+    {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < b.limbs.size(); ++j)
+        {
+            const uint64_t t = (uint64_t)a.limbs[i] * b.limbs[j] + r.limbs[i + j] + carry;
+            r.limbs[i + j] = (uint32_t)t;
+            carry = t >> 32;
+        }
+        r.limbs[i + b.limbs.size()] = (uint32_t)carry;
+    }
+    r.negative = a.negative != b.negative;
+    r.trim();
+    return r;
+}
+
+bool BigInt::divmod(const BigInt &a, const BigInt &b, BigInt &quotient, BigInt &remainder)
+{
+    if (b.isZero())
+        return false;
+    std::vector<uint32_t> q, r;
+    divideMagnitude(a.limbs, b.limbs, q, r);
+    quotient.limbs = q;
+    quotient.negative = a.negative != b.negative;
+    quotient.trim();
+    remainder.limbs = r;
+    remainder.negative = a.negative;
+    remainder.trim();
+    return true;
+}
+
+// 4. Integer : literal (18 digits always fit int64, longer one go through BigInt)
+ArithError Integer::fromLiteral(const std::string &digits, Integer &out)
+{
+    if (digits.size() <= 18)
+    {
+        long long v = 0;
+        for (char c : digits)
+            v = v * 10 + (c - '0');
+        out = Integer(v);
+        return ArithError::NONE;
+    }
+
+    // Too many significant digits for MAX_BITS : refused before the (quadratic) conversion
+    const size_t first = std::min(digits.find_first_not_of('0'), digits.size());
+    if ((digits.size() - first) > MAX_BITS * 30103 / 100000 + 1)
+        return ArithError::TOO_LARGE;
+    return fromBig(BigInt::fromDecimal(digits.substr(first)), out);
+}
+
+std::string Integer::toString() const { return big ? big->value.toString() : std::to_string(small); }
+
+// 4.1 Normalize a BigInt result (Demote to int64 when it fit : later operations take the fast path again)
+ArithError Integer::fromBig(BigInt &&value, Integer &out)
+{
+    long long v = 0;
+    if (value.toInt64(v))
+    {
+        out.release();
+        out.small = v;
+        return ArithError::NONE;
+    }
+    if (value.bitLength() > MAX_BITS)
+        return ArithError::TOO_LARGE;
+    out.release();
+    out.small = 0;
+    out.big = new Shared{std::move(value), 1};
+    return ArithError::NONE;
+}
+
+// 4.2 Slow path of + - * (Overflowed or big operand)
+ArithError Integer::slowAdd(const Integer &a, const Integer &b, Integer &out) { return fromBig(BigInt::add(a.toBig(), b.toBig()), out); }
+ArithError Integer::slowSub(const Integer &a, const Integer &b, Integer &out) { return fromBig(BigInt::sub(a.toBig(), b.toBig()), out); }
+
+ArithError Integer::slowMul(const Integer &a, const Integer &b, Integer &out)
+{
+    const BigInt x = a.toBig(), y = b.toBig();
+    if (x.bitLength() + y.bitLength() > MAX_BITS + 1) // Checked before the product is built
+        return ArithError::TOO_LARGE;
+    return fromBig(BigInt::mul(x, y), out);
+}
+
+// 4.3 Slow path of / % (Big operand, divisor 0 or LLONG_MIN / -1)
+ArithError Integer::slowDiv(const Integer &a, const Integer &b, Integer &out)
+{
+    if (b.isZero())
+        return ArithError::DIVISION_BY_ZERO;
+    BigInt q, r;
+    BigInt::divmod(a.toBig(), b.toBig(), q, r);
+    return fromBig(std::move(q), out);
+}
+
+ArithError Integer::slowMod(const Integer &a, const Integer &b, Integer &out)
+{
+    if (b.isZero())
+        return ArithError::DIVISION_BY_ZERO;
+    BigInt q, r;
+    BigInt::divmod(a.toBig(), b.toBig(), q, r);
+    return fromBig(std::move(r), out);
+}
+
+// 4.4 Power (Square and multiply on Integer : stay on the fast path while it fit)
+ArithError Integer::pow(const Integer &a, const Integer &b, Integer &out)
+{
+    // A. Base 0, 1, -1 or negative exponent : known from sign + parity alone (Exponent of any size)
+    const bool unit = !a.big && (a.small == 1 || a.small == -1);
+    const bool negativeExponent = b.big ? b.big->value.isNegative() : b.small < 0;
+    const bool odd = b.big ? b.big->value.isOdd() : (b.small & 1);
+    if (negativeExponent && a.isZero())
+        return ArithError::DIVISION_BY_ZERO;
+    if (unit)
+    {
+        out = Integer(a.small == -1 && odd ? -1 : 1);
+        return ArithError::NONE;
+    }
+    if (negativeExponent || a.isZero())
+    {
+        out = Integer(b.isZero() ? 1 : 0);
+        return ArithError::NONE;
+    }
+
+    // |a| >= 2 : result has at least b bits
+    const size_t baseBits = a.big ? a.big->value.bitLength() : 64 - (size_t)__builtin_clzll(a.small < 0 ? 0ULL - (unsigned long long)a.small : (unsigned long long)a.small);
+    if (b.big || (unsigned long long)b.small > MAX_BITS / (baseBits - 1 ? baseBits - 1 : 1))
+        return ArithError::TOO_LARGE;
+
+    Integer result(1), square = a;
+    for (long long e = b.small; e > 0; e >>= 1)
+    {
+        ArithError err = ArithError::NONE;
+        if ((e & 1) && (err = mul(result, square, result)) != ArithError::NONE)
+            return err;
+        if (e > 1 && (err = mul(square, square, square)) != ArithError::NONE)
+            return err;
+    }
+    out = result;
+    return ArithError::NONE;
+}
+
+// 4.5 Unary minus (-LLONG_MIN is 2^63 : promoted)
+ArithError Integer::negate(const Integer &a, Integer &out)
+{
+    if (!a.big && a.small != LLONG_MIN)
+    {
+        out.release();
+        out.small = -a.small;
+        return ArithError::NONE;
+    }
+    return fromBig(a.toBig().negated(), out);
+}
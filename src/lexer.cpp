@@ -1,23 +1,179 @@
 #include "../include/lexer.hpp"     // Reference to Class header
+#include "../include/trace.hpp"
 #include <iostream>
 #include <iomanip>
 #include <string>
 #include <cctype>
 #include <map>
 #include <sstream>
+#include <algorithm>
+#include <iterator>
+#include <thread>
 
 // Constructor Lexer (Initialize counter to 0/start)
-Lexer::Lexer(const std::string &text) : input(text), pos(0), IDENTIFIER(0), NUMBER(0), OPERATOR(0), ASSIGNMENT(0), PARENTHESES(0), STATEMENT_TERMINATOR(0), INVALID(0) {}
+Lexer::Lexer(const std::string &text) : input(text), pos(0), IDENTIFIER(0), NUMBER(0), OPERATOR(0), ASSIGNMENT(0), PARENTHESES(0), STATEMENT_TERMINATOR(0), INVALID(0), index(input.data(), input.size()) {}
 
-// Tokenize : Scan input string & return vector token (9 Cases)
+// Tokenize : Scan whole input string & return vector token
 std::vector<Token> Lexer::tokenize()
 {
+    TraceSpan span("tokenize");
     std::vector<Token> tokens;
+    TokenCounts counts;
+
+    scanRange(pos, input.size(), tokens, counts);
+    pos = input.size();
+    if (counts.stopped != ResourceLimits::Kind::NONE)
+        return exceed(counts.stopped);
+
+    addCounts(counts);
+    internSymbols(tokens);
+    collectErrors(tokens);
+    if (limitExceeded())
+        return std::vector<Token>();
+    return tokens;
+}
+
+// Budget ran out : Only the LimitError is kept (Token scanned so far are released with the returned list)
+std::vector<Token> Lexer::exceed(ResourceLimits::Kind kind)
+{
+    exceeded = kind;
+    lexicalErrors.assign(1, limits->message(kind));
+    return std::vector<Token>();
+}
+
+// Tokenize Parallel : Cut input into per-thread chunks, scan them at the same time, then concatenate
+// Token cannot span whitespace or ';', so every cut is placed right after one (same result as tokenize)
+std::vector<Token> Lexer::tokenizeParallel(unsigned threads)
+{
+    TraceSpan span("tokenizeParallel");
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Small input : thread start-up cost more than the scan itself
+    const size_t remaining = input.size() - pos;
+    if (threads == 1 || remaining < threads * MIN_PARALLEL_CHUNK)
+        return tokenize();
+
+    // A. Chunk boundaries (Move each cut forward to just after whitespace or ';')
+    std::vector<size_t> cuts;
+    cuts.push_back(pos);
+    for (unsigned i = 1; i < threads; ++i)
+    {
+        size_t cut = std::max(pos + remaining * i / threads, cuts.back());
+        while (cut < input.size() && !(std::isspace((unsigned char)input[cut]) || input[cut] == ';'))
+            ++cut;
+        if (cut < input.size())
+            ++cut; // cut after the delimiter
+        if (cut > cuts.back() && cut < input.size())
+            cuts.push_back(cut);
+    }
+    cuts.push_back(input.size());
+
+    // B. Scan every chunk on its own thread (Token + counter are per chunk, nothing shared is written)
+    const size_t chunks = cuts.size() - 1;
+    std::vector<std::vector<Token>> parts(chunks);
+    std::vector<TokenCounts> partCounts(chunks);
+    std::vector<std::thread> workers;
+    const TraceTask task = Trace::task();                   // Worker spans belong to this statement
+    auto scanChunk = [&, task](size_t i)
+    {
+        Trace::adopt(task);
+        TraceSpan chunk("scanChunk");
+        scanRange(cuts[i], cuts[i + 1], parts[i], partCounts[i]);
+    };
+    for (size_t i = 1; i < chunks; ++i)
+        workers.emplace_back(scanChunk, i);
+    scanChunk(0); // Calling thread take the first chunk
+    for (auto &w : workers)
+        w.join();
+    pos = input.size();
+
+    // C. Concatenate in order + reduce counters (Budget checked on every chunk, then on statements spanning a cut)
+    size_t total = 0;
+    for (size_t i = 0; i < chunks; ++i)
+    {
+        if (partCounts[i].stopped != ResourceLimits::Kind::NONE)
+            return exceed(partCounts[i].stopped);
+        total += parts[i].size();
+    }
+    if (limits && limits->maxTokens)
+    {
+        size_t run = 0;         // Token since the last ';'
+        for (const auto &part : parts)
+        {
+            for (const auto &t : part)
+            {
+                run = (t.type == TokenType::STATEMENT_TERMINATOR) ? 0 : run + 1;
+                if (run > limits->maxTokens)
+                    return exceed(ResourceLimits::Kind::TOKENS);
+            }
+        }
+    }
+
+    std::vector<Token> tokens;
+    tokens.reserve(total);
+    for (size_t i = 0; i < chunks; ++i)
+    {
+        std::move(parts[i].begin(), parts[i].end(), std::back_inserter(tokens));
+        addCounts(partCounts[i]);
+    }
+
+    internSymbols(tokens);
+    collectErrors(tokens);
+    if (limitExceeded())
+        return std::vector<Token>();
+    return tokens;
+}
+
+// Add a chunk counter into the Lexer counter
+void Lexer::addCounts(const TokenCounts &counts)
+{
+    IDENTIFIER += counts.IDENTIFIER;
+    NUMBER += counts.NUMBER;
+    OPERATOR += counts.OPERATOR;
+    ASSIGNMENT += counts.ASSIGNMENT;
+    PARENTHESES += counts.PARENTHESES;
+    STATEMENT_TERMINATOR += counts.STATEMENT_TERMINATOR;
+    INVALID += counts.INVALID;
+}
+
+// Scan Range : Tokenize input[begin, end) into tokens (10 Cases)
+// Only read shared state, so several ranges can be scanned at the same time (Offsets are already absolute)
+void Lexer::scanRange(size_t begin, size_t end, std::vector<Token> &tokens, TokenCounts &counts) const
+{
+    size_t pos = begin;     // Current Index Position (local, not the member)
+
+    // Budget : Token count of the current statement compared every loop, clock read every 4096 loop
+    const size_t maxTokens = (limits && limits->maxTokens) ? limits->maxTokens : (size_t)-1;
+    const bool timed = limits && limits->timeoutMs;
+    size_t steps = 0;
+    size_t statementStart = 0;  // First Token after the last ';' (Whole program lexed at once : budget is per statement)
 
     // Loop through input string one by one (Almost like a pointer)
-    while (pos < input.size())
+    while (pos < end)
     {
-        char c = input[pos];
+        if (tokens.size() - statementStart > maxTokens)
+        {
+            counts.stopped = ResourceLimits::Kind::TOKENS;
+            return;
+        }
+        if (timed && (++steps & 4095) == 0 && limits->expired())
+        {
+            counts.stopped = ResourceLimits::Kind::DEADLINE;
+            return;
+        }
+
+        unsigned char c = (unsigned char)input[pos];
+
+        if (c >= 0x80)          // 0. Non-ASCII code point (One Invalid token per code point, not per byte)
+        {
+            bool valid = false;
+            const size_t len = utf8::decode(input.data(), end, pos, valid);
+            tokens.emplace_back(TokenType::INVALID, input.substr(pos, len), pos);
+            pos += len;
+            counts.INVALID++;
+            continue;
+        }
 
         if (std::isspace(c))    // 1. Skip Whitespace
         {
@@ -28,9 +184,20 @@ std::vector<Token> Lexer::tokenize()
         if (std::isalpha(c))    // 2. Identifier (lowercase single)
         { 
             size_t start_pos = pos;
+
+            // 2.1 Extended mode : letter { letter | digit | '_' } (Interned after the scan, ranges may run concurrently)
+            if (symbols)
+            {
+                while (pos < end && (std::isalnum((unsigned char)input[pos]) || input[pos] == '_'))
+                    pos++;
+                tokens.emplace_back(TokenType::IDENTIFIER, input.substr(start_pos, pos - start_pos), start_pos);
+                counts.IDENTIFIER++;
+                continue;
+            }
+
             std::string letters;
             
-            while (pos < input.size() && std::isalpha(input[pos]))
+            while (pos < end && std::isalpha((unsigned char)input[pos]))
             {
                 letters += input[pos];
                 pos++;
@@ -39,12 +206,13 @@ std::vector<Token> Lexer::tokenize()
             if (letters.length() == 1 && std::islower(letters[0]))
             {
                 tokens.emplace_back(TokenType::IDENTIFIER, letters, start_pos);
-                IDENTIFIER++;
+                tokens.back().symbol = (uint32_t)(letters[0] - 'a'); // Same id SymbolTable give to 'a' ... 'z'
+                counts.IDENTIFIER++;
             }
             else
             {
                 tokens.emplace_back(TokenType::INVALID, letters, start_pos);
-                INVALID++;
+                counts.INVALID++;
                 pos++;
             }
         }
@@ -52,65 +220,105 @@ std::vector<Token> Lexer::tokenize()
         { 
             size_t start_pos = pos;
             std::string num;
-            while (pos < input.size() && std::isdigit(input[pos]))
+            while (pos < end && std::isdigit((unsigned char)input[pos]))
             {
                 num += input[pos++];
             }
 
             tokens.emplace_back(TokenType::NUMBER, num, start_pos);
-            NUMBER++;
+            counts.NUMBER++;
         }
-        else if (c == '+' || c == '-' || c == '*' || c == '/')  // 4. Operator
+        else if (c == '+' || c == '-' || c == '*' || c == '/' || c == '%' || c == '^')  // 4. Operator
         {
             tokens.emplace_back(TokenType::OPERATOR, std::string(1, c), pos);
             pos++;
-            OPERATOR++;
+            counts.OPERATOR++;
         }
         else if (c == '=')  // 5. Assignment ("=")
         {
             tokens.emplace_back(TokenType::ASSIGNMENT, std::string(1, c), pos);
             pos++;
-            ASSIGNMENT++;
+            counts.ASSIGNMENT++;
         }
         else if (c == '(')  // 6. Left Parentheses
         { 
             tokens.emplace_back(TokenType::LEFT_PAREN, "(", pos);
             pos++;
-            PARENTHESES++;
+            counts.PARENTHESES++;
         }
         else if (c == ')')  // 7. Right Parentheses
         { 
             tokens.emplace_back(TokenType::RIGHT_PAREN, ")", pos);
             pos++;
-            PARENTHESES++;
+            counts.PARENTHESES++;
         }
         else if (c == ';')  // 8. Statement Terminator
         {
             tokens.emplace_back(TokenType::STATEMENT_TERMINATOR, ";", pos);
             pos++;
-            STATEMENT_TERMINATOR++;
+            counts.STATEMENT_TERMINATOR++;
+            statementStart = tokens.size();
         }
         else    // 9. Invalid Token
         {
             tokens.emplace_back(TokenType::INVALID, std::string(1, c), pos);
             pos++;
-            INVALID++;
+            counts.INVALID++;
         }
     }
+}
+
+// Intern Extended Identifiers (Single-threaded pass, after every range is scanned)
+void Lexer::internSymbols(std::vector<Token> &tokens)
+{
+    if (!symbols)
+        return;
+    for (auto &t : tokens)
+    {
+        if (t.type == TokenType::IDENTIFIER)
+            t.symbol = symbols->intern(t.value);
+    }
+}
 
-    // Collect Lexical Errors (Case 9 : Invalid Token) found
+// Collect Lexical Errors (Case 0 / 9 : Invalid Token) found
+void Lexer::collectErrors(const std::vector<Token> &tokens)
+{
     lexicalErrors.clear();
     for (const auto &t : tokens)
     {
-        if (t.type == TokenType::INVALID)
+        if (t.type != TokenType::INVALID)
+            continue;
+        if (limits && limits->maxDiagnostics && lexicalErrors.size() >= limits->maxDiagnostics)
         {
-            std::stringstream ss;
-            ss << "LexicalError at position " << t.start_pos
-            << ": invalid character '" << t.value << "'";
-            lexicalErrors.push_back(ss.str());
+            exceeded = ResourceLimits::Kind::DIAGNOSTICS; // Keep the first ones + LimitError
+            lexicalErrors.push_back(limits->message(exceeded));
+            return;
         }
+        lexicalErrors.push_back(lexicalError(index, t.start_pos, t.value));
     }
-    return tokens;
+}
+
+// Message of one Invalid Token (Shared with Recognizer)
+std::string Lexer::lexicalError(const SourceIndex &index, size_t position, const std::string &text)
+{
+    std::stringstream ss;
+    ss << "LexicalError at " << index.describe(position);
+
+    // Malformed UTF-8 is shown as hex bytes (printing it raw would garble the terminal)
+    bool valid = true;
+    if ((unsigned char)text[0] >= 0x80)
+        utf8::decode(text.data(), text.size(), 0, valid);
+
+    if (valid)
+        ss << ": invalid character '" << text << "'";
+    else
+    {
+        ss << ": invalid UTF-8 sequence '";
+        for (unsigned char b : text)
+            ss << "\\x" << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << (int)b;
+        ss << "'";
+    }
+    return ss.str();
 }
 
 // Print summary of Token Count
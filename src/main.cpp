@@ -1,11 +1,647 @@
 #include "../include/lexer.hpp"
 #include "../include/parser.hpp"
+#include "../include/range_analysis.hpp"
+#include "../include/alloc_trace.hpp"
+#include "../include/trace.hpp"
+#include "../include/recognizer.hpp"
+#include "../include/program.hpp"
+#include "../include/parallel_executor.hpp"
+#include "../include/state_store.hpp"
+#include "../include/exact_evaluator.hpp"
+#include "../include/persistent_env.hpp"
+#include "../include/reassociate.hpp"
+#include "../include/shm_ring.hpp"
+#include "../include/codegen.hpp"
+#include "../include/exporter.hpp"
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <vector>
 #include <iomanip>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <deque>
+#include <filesystem>
 
-int main()
+// Optional Tracing : COMPY_TRACE=<file.json> (Chrome trace), COMPY_TRACE_SAMPLE=N record 1 statement in N
+// Set up before the mode dispatch, file written at exit whatever the mode and the exit path
+static const char *traceFile = nullptr;
+
+static void writeTrace()
+{
+    Trace::disable();
+    std::ofstream file(traceFile);
+    Trace::writeChromeJson(file);
+}
+
+// Validation only mode (main --check) : one line per statement, print "valid" or the first diagnostic
+static int checkOnly(bool extended)
+{
+    std::string line;
+    while (std::getline(std::cin, line) && line != "exit")
+    {
+        Trace::beginStatement();
+        Recognizer::Result result = Recognizer::check(line, extended);
+        if (result.valid)
+            std::cout << "valid\n";
+        else
+            std::cout << Recognizer::message(line, result) << "\n";
+    }
+    return 0;
+}
+
+// Parallel lexing mode (main --lex-parallel [threads]) : whole stdin lexed once serially and once in chunks,
+// both token lists must match, then time and tokens/s of each
+static int lexParallel(unsigned threads, SymbolTable &symbols, bool extended)
+{
+    const std::string source((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // A. Best of 3 runs each (Fresh Lexer every run : tokenize consume the input)
+    auto timed = [&](bool parallel, std::vector<Token> &tokens, std::vector<std::string> &errors) -> double
+    {
+        double best = 0.0;
+        for (int run = 0; run < 3; ++run)
+        {
+            Trace::beginStatement();
+            Lexer lexer(source);
+            lexer.setSymbolTable(extended ? &symbols : nullptr);
+            const auto start = std::chrono::steady_clock::now();
+            tokens = parallel ? lexer.tokenizeParallel(threads) : lexer.tokenize();
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            best = run ? std::min(best, ms) : ms;
+            errors = lexer.getLexicalErrors();
+        }
+        return best;
+    };
+    std::vector<Token> serialTokens, parallelTokens;
+    std::vector<std::string> serialErrors, parallelErrors;
+    const double serialMs = timed(false, serialTokens, serialErrors);
+    const double parallelMs = timed(true, parallelTokens, parallelErrors);
+
+    // B. Same Token list (Kind, text, offset, symbol) and same lexical errors
+    bool same = serialTokens.size() == parallelTokens.size() && serialErrors == parallelErrors;
+    for (size_t i = 0; same && i < serialTokens.size(); ++i)
+    {
+        const Token &a = serialTokens[i], &b = parallelTokens[i];
+        same = a.type == b.type && a.value == b.value && a.start_pos == b.start_pos && a.symbol == b.symbol;
+    }
+    if (!same)
+    {
+        std::cerr << "LexError: parallel Token list differ from the serial one." << std::endl;
+        return 1;
+    }
+
+    const double count = (double)serialTokens.size();
+    char line[192];
+    std::snprintf(line, sizeof(line), "Tokens: %zu (%zu bytes), lexical errors: %zu", serialTokens.size(), source.size(), serialErrors.size());
+    std::cout << line << std::endl;
+    std::snprintf(line, sizeof(line), "Serial: %.3f ms (%.1f M tokens/s)", serialMs, serialMs > 0.0 ? count / serialMs / 1e3 : 0.0);
+    std::cout << line << std::endl;
+    std::snprintf(line, sizeof(line), "Parallel: %.3f ms with %u threads (%.1f M tokens/s), speedup %.2fx", parallelMs, threads,
+                  parallelMs > 0.0 ? count / parallelMs / 1e3 : 0.0, parallelMs > 0.0 ? serialMs / parallelMs : 0.0);
+    std::cout << line << std::endl;
+    return 0;
+}
+
+// Export mode (main --export json|sexpr|dot) : one statement per line, tree streamed to stdout for other tools
+// json = one object per line {"tokens":[...],"tree":...}, tree null when the statement is invalid (Diagnostics on stderr)
+static int exportTrees(const char *format, SymbolTable &symbols, bool extended)
 {
+    const bool json = std::strcmp(format, "json") == 0, sexpr = std::strcmp(format, "sexpr") == 0, dot = std::strcmp(format, "dot") == 0;
+    if (!json && !sexpr && !dot)
+    {
+        std::cerr << "ExportError: unknown format '" << format << "' (json, sexpr or dot)." << std::endl;
+        return 1;
+    }
+
+    TreeExporter exporter(std::cout);       // One buffer for the whole stream
+    std::string line;
+    bool ok = true;
+    while (std::getline(std::cin, line) && line != "exit")
+    {
+        Trace::beginStatement();
+        Lexer lexer(line);
+        lexer.setSymbolTable(extended ? &symbols : nullptr);
+        const std::vector<Token> tokens = lexer.tokenize();
+        Parser parser(tokens);
+        parser.setSourceIndex(&lexer.getSourceIndex());
+        const bool valid = parser.parse() && !lexer.hasLexicalErrors();
+        if (!valid)
+        {
+            exporter.flush(); // Keep stdout / stderr in input order
+            for (const auto &err : lexer.getLexicalErrors())
+                std::cerr << err << std::endl; // stdout carry only the export
+            parser.printErrors();
+            ok = false;
+        }
+
+        const Parser::Node *root = valid ? parser.getRoot() : nullptr;
+        if (json)
+            exporter.writeJson(tokens, root);
+        else if (sexpr)
+            exporter.writeSExpr(root);
+        else
+            exporter.writeDot(root);
+    }
+    exporter.flush();
+    return ok ? 0 : 1;
+}
+
+// Program mode (main --run [threads]) : whole stdin is one program, statements run in parallel by dependency
+// --state <base> : variables restored from <base>.snap + <base>.log first, every assignment logged after
+// --exact : no wrap around (int64 until an operation overflow, then arbitrary precision), statements run in order
+static int runProgram(unsigned threads, SymbolTable &symbols, bool extended, const ResourceLimits *limits, const char *statePath, bool exact, bool balance)
+{
+    if (exact && statePath)
+    {
+        std::cerr << "StateError: state file keep 64-bit values, --state cannot be used with --exact." << std::endl;
+        return 1;
+    }
+    Trace::beginStatement();                            // Whole program = one statement (Executor workers adopt it)
+
+    // A. Restore state before compiling (Extended names must get back their saved id)
+    Evaluator env;
+    std::unique_ptr<StateStore> store;
+    if (statePath)
+    {
+        store.reset(new StateStore(statePath, &symbols));
+        if (!store->load(env))
+        {
+            std::cerr << "StateError: " << store->getError() << std::endl;
+            return 1;
+        }
+        env.setJournal(store.get());
+        if (extended)
+            symbols.usePerfectHash({}); // Names of earlier runs known : the program's lexer find them without probing
+    }
+
+    std::string source((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+    Program program(source, extended ? &symbols : nullptr);
+    if (limits)
+        program.setLimits(*limits);
+    program.setExact(exact);
+    program.setBalance(balance);
+    if (!program.compile())
+    {
+        program.printErrors();
+        return 1;
+    }
+
+    // Exact mode (Big value do not fit the executor's 64-bit result cells : sequential)
+    if (exact)
+    {
+        ExactEvaluator exactEnv;
+        const bool ok = exactEnv.run(program.statements());
+        if (!ok)
+            exactEnv.printErrors();
+        for (size_t slot = 0; slot < exactEnv.variables().size(); ++slot)
+        {
+            if (!exactEnv.get(slot).isZero())
+                std::cout << symbols.name((uint32_t)slot) << " = " << exactEnv.get(slot).toString() << "\n";
+        }
+        return ok ? 0 : 1;
+    }
+
+    // Run once (Speedup over Evaluator::run is measured by bench/run_bench.sh parallel, not here)
+    ParallelExecutor executor(threads);
+    const bool ok = executor.run(program.statements(), env);
+    if (!ok)
+        env.printErrors();
+
+    // B. Log to disk, compact into a new snapshot once the log is long
+    if (store)
+    {
+        const bool saved = store->logRecords() >= StateStore::SNAPSHOT_EVERY ? store->snapshot(env) : store->flush();
+        if (!saved)
+            std::cerr << "StateError: " << store->getError() << std::endl;
+    }
+
+    // Variables that were assigned (Non-zero)
+    for (size_t slot = 0; slot < env.variables().size(); ++slot)
+    {
+        if (env.get(slot) != 0)
+            std::cout << symbols.name((uint32_t)slot) << " = " << env.get(slot) << "\n";
+    }
+    executor.printStats();
+    program.analysis().printStats();
+    if (balance)
+        program.reassociation().printStats();
+    if (store)
+    {
+        char line[128];
+        std::snprintf(line, sizeof(line), "State: restored in %.3f ms, %zu assignments logged since snapshot",
+                      store->loadMs(), store->logRecords());
+        std::cout << line << std::endl;
+    }
+    return ok ? 0 : 1;
+}
+
+// Native mode (main --native) : whole stdin translated to C++, built by the local g++, loaded and run once
+// Same variables and runtime error as --run, then the build / run time
+static int runNative(SymbolTable &symbols, bool extended, const ResourceLimits *limits, bool balance)
+{
+    Trace::beginStatement();
+    std::string source((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+    Program program(source, extended ? &symbols : nullptr);
+    if (limits)
+        program.setLimits(*limits);
+    program.setBalance(balance);
+    if (!program.compile())
+    {
+        program.printErrors();
+        return 1;
+    }
+
+    // A. Generate + build in a private temporary directory (Removed afterwards)
+    CodeGen gen(program.statements());
+    const std::string code = gen.emit();
+    std::error_code ec;
+    const std::filesystem::path dir = std::filesystem::temp_directory_path(ec) /
+        ("compy-native-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    if (ec || !std::filesystem::create_directory(dir, ec))
+    {
+        std::cerr << "NativeError: cannot create a temporary directory." << std::endl;
+        return 1;
+    }
+    NativeProgram native;
+    const auto buildStart = std::chrono::steady_clock::now();
+    const bool built = native.build(code, (dir / "program").string());
+    const double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+    if (!built)
+    {
+        std::cerr << "NativeError: " << native.getError() << std::endl;
+        std::filesystem::remove_all(dir, ec);
+        return 1;
+    }
+
+    // B. Run (Returned statement number = first division by zero, earlier writes kept like Evaluator::run)
+    std::vector<long long> vars(gen.slotCount(), 0);
+    const auto runStart = std::chrono::steady_clock::now();
+    const int failed = native.run(vars.data());
+    const double runMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runStart).count();
+    std::filesystem::remove_all(dir, ec);
+    if (failed)
+        std::cerr << "RuntimeError: division by zero." << std::endl;
+
+    for (size_t slot = 0; slot < vars.size(); ++slot)
+    {
+        if (vars[slot] != 0)
+            std::cout << symbols.name((uint32_t)slot) << " = " << vars[slot] << "\n";
+    }
+    char line[128];
+    std::snprintf(line, sizeof(line), "Native: %zu statements, built in %.1f ms, ran in %.3f ms", program.size(), buildMs, runMs);
+    std::cout << line << std::endl;
+    return failed ? 1 : 0;
+}
+
+// What-if mode (main --variants [threads]) : stdin = base statements, then variants separated by "---" lines
+// Each variant run on its own fork of the base state (O(1), unchanged variables stay shared), variants run concurrently
+static int runVariants(unsigned threads, SymbolTable &symbols, bool extended, const ResourceLimits *limits, bool balance)
+{
+    // A. Split sections, compile each one (Shared symbol table : same name = same slot in every variant)
+    std::vector<std::unique_ptr<Program>> sections;
+    std::string line, text;
+    auto addSection = [&]()
+    {
+        sections.emplace_back(new Program(text, extended ? &symbols : nullptr));
+        text.clear();
+    };
+    while (std::getline(std::cin, line))
+    {
+        if (line == "---")
+            addSection();
+        else
+            text += line + "\n";
+    }
+    addSection();
+
+    bool compiled = true;
+    for (size_t k = 0; k < sections.size(); ++k)
+    {
+        Trace::beginStatement();                        // One statement per section compiled
+        if (limits)
+            sections[k]->setLimits(*limits);
+        sections[k]->setBalance(balance);
+        if (!sections[k]->compile() && sections[k]->hasErrors())
+        {
+            for (const auto &err : sections[k]->getErrors())
+                std::cerr << (k ? "Variant " + std::to_string(k) + ": " : "Base: ") << err << std::endl;
+            compiled = false;
+        }
+        if (k == 0 && extended)
+            symbols.usePerfectHash({}); // Built once over the base names : every variant find them without probing
+    }
+    if (!compiled)
+        return 1;
+
+    // B. Base state
+    PersistentEnv base;
+    Evaluator baseEnv;
+    baseEnv.setEnvironment(&base);
+    if (!baseEnv.run(sections[0]->statements()))
+    {
+        baseEnv.printErrors();
+        return 1;
+    }
+    const size_t baseNodes = PersistentEnv::liveNodes();
+
+    // C. Fork every variant (Timed alone : cost of starting a variant from the base)
+    const size_t count = sections.size() - 1;
+    std::vector<PersistentEnv> versions(count);
+    const auto forkStart = std::chrono::steady_clock::now();
+    for (auto &version : versions)
+        version = base.fork();
+    const double forkNs = count ? std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - forkStart).count() / (double)count : 0.0;
+
+    // D. Run variants (Each worker take the next variant, every version only touched by its worker)
+    std::vector<std::vector<std::string>> failures(count);
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+        for (size_t k; (k = next.fetch_add(1)) < count;)
+        {
+            Trace::beginStatement();                    // Sampling decided on the thread running the variant
+            TraceSpan span("variant");
+            Evaluator env;
+            env.setEnvironment(&versions[k]);
+            if (!env.run(sections[k + 1]->statements()))
+                failures[k] = env.getErrors();
+        }
+    };
+    const unsigned workers = (unsigned)std::max<size_t>(1, std::min<size_t>(threads ? threads : std::max(1u, std::thread::hardware_concurrency()), count));
+    std::vector<std::thread> pool;
+    for (unsigned w = 1; w < workers; ++w)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &t : pool)
+        t.join();
+
+    // E. Base variables, then what each variant changed
+    for (const auto &change : base.changes(PersistentEnv()))
+        std::cout << symbols.name((uint32_t)change.first) << " = " << change.second << "\n";
+    bool ok = true;
+    for (size_t k = 0; k < count; ++k)
+    {
+        std::ostringstream out;
+        out << "Variant " << k + 1 << ":";
+        if (!failures[k].empty())
+        {
+            out << " " << failures[k].front();
+            ok = false;
+        }
+        else
+        {
+            const auto changed = versions[k].changes(base);
+            for (size_t c = 0; c < changed.size(); ++c)
+                out << (c ? ", " : " ") << symbols.name((uint32_t)changed[c].first) << " = " << changed[c].second;
+            if (changed.empty())
+                out << " (no change)";
+        }
+        std::cout << out.str() << "\n";
+    }
+
+    const size_t newNodes = PersistentEnv::liveNodes() - baseNodes;
+    char summary[192];
+    std::snprintf(summary, sizeof(summary), "Variants: %zu, fork %.1f ns, %zu new nodes (%.0f bytes per variant, full copy %zu bytes)",
+                  count, forkNs, newNodes, count ? (double)(newNodes * PersistentEnv::NODE_BYTES) / (double)count : 0.0, baseNodes * PersistentEnv::NODE_BYTES);
+    std::cout << summary << std::endl;
+    return ok ? 0 : 1;
+}
+
+// Shared-memory mode (main --shm <name> [threads]) : co-located producers put statements into a shared-memory ring,
+// compiler threads validate each one in place (Same verdict as --check) and publish it to the response ring
+// A statement "exit" stop the compiler, the ring name is removed on the way out
+static int serveRing(const char *name, unsigned threads, bool extended)
+{
+    ShmRing ring;
+    if (!ring.create(name))
+    {
+        std::cerr << ring.getError() << std::endl;
+        return 1;
+    }
+
+    std::atomic<uint64_t> served(0);
+    auto worker = [&]()
+    {
+        ShmRing::Request request;
+        for (unsigned idle = 0; !ring.stopped();)
+        {
+            if (!ring.acquire(request))
+            {
+                ShmRing::backoff(idle);
+                continue;
+            }
+            idle = 0;
+            Trace::beginStatement();                    // Sampling decided on the compiler thread that took it
+            if (request.size == 4 && std::memcmp(request.data, "exit", 4) == 0)
+            {
+                ring.release(request);
+                ring.stop();
+                break;
+            }
+
+            // A. Lex + parse straight over the slot bytes, slot kept until the verdict is out (Back pressure)
+            ShmRing::Response response;
+            response.id = request.id;
+            response.producer = request.producer;
+            response.result = Recognizer::check(request.data, request.size, extended);
+            for (unsigned wait = 0; !ring.publish(response) && !ring.stopped();)
+                ShmRing::backoff(wait);
+            ring.release(request);
+            served.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+    const unsigned workers = std::max(1u, threads);
+    std::vector<std::thread> pool;
+    for (unsigned w = 1; w < workers; ++w)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &t : pool)
+        t.join();
+
+    ShmRing::unlink(name);
+    std::cerr << "Served " << served.load() << " statements." << std::endl;
+    return 0;
+}
+
+// Shared-memory producer (main --shm-client <name>) : stdin line by line into the ring, verdicts printed in input order
+// Output is the same as --check; "exit" is forwarded and stop the compiler
+static int ringClient(const char *name)
+{
+    ShmRing ring;
+    if (!ring.open(name))
+    {
+        std::cerr << ring.getError() << std::endl;
+        return 1;
+    }
+
+    // A. Verdicts arrive in completion order : keep statement text until its turn to be printed
+    struct Entry
+    {
+        std::string text;
+        bool arrived = false;
+        bool tooLong = false;                   // Never sent (Does not fit a slot)
+        Recognizer::Result result;
+    };
+    std::deque<Entry> pending;                  // Statement of id printed + i
+    uint64_t printed = 0, sent = 0, unexpected = 0;
+    auto drain = [&]() -> bool
+    {
+        bool progress = false;
+        ShmRing::Response response;
+        while (ring.collect(response))
+        {
+            if (response.id < printed || response.id - printed >= pending.size() || pending[(size_t)(response.id - printed)].arrived)
+            {
+                ++unexpected; // Not a statement waiting here (Region written by another process : never trusted)
+                continue;
+            }
+            Entry &entry = pending[(size_t)(response.id - printed)];
+            entry.arrived = true;
+            entry.result = response.result;
+            progress = true;
+        }
+        for (; !pending.empty() && pending.front().arrived; ++printed)
+        {
+            const Entry &entry = pending.front();
+            if (entry.tooLong)
+                std::cout << "RingError: statement is longer than " << ShmRing::SLOT_BYTES << " bytes.\n";
+            else if (entry.result.valid)
+                std::cout << "valid\n";
+            else
+                std::cout << Recognizer::message(entry.text, entry.result) << "\n";
+            pending.pop_front();
+        }
+        return progress;
+    };
+
+    // B. Submit every line (Drain responses while the request ring is full)
+    std::string line;
+    bool exitSeen = false;
+    while (std::getline(std::cin, line))
+    {
+        if (line == "exit")
+        {
+            exitSeen = true;
+            break;
+        }
+        pending.emplace_back();
+        pending.back().text = line;
+        if (line.size() > ShmRing::SLOT_BYTES)
+        {
+            pending.back().arrived = pending.back().tooLong = true;
+            ++sent;
+            continue;
+        }
+        for (unsigned idle = 0; !ring.submit(sent, line.data(), line.size());)
+        {
+            if (ring.stopped())
+            {
+                std::cerr << "RingError: compiler stopped." << std::endl;
+                return 1;
+            }
+            if (!drain())
+                ShmRing::backoff(idle);
+        }
+        ++sent;
+        if (pending.size() >= 1024)
+            drain();
+    }
+
+    // C. Wait for the rest (Compiler gone = stop instead of waiting forever)
+    auto last = std::chrono::steady_clock::now();
+    for (unsigned idle = 0; printed < sent;)
+    {
+        if (drain())
+        {
+            idle = 0;
+            last = std::chrono::steady_clock::now();
+            continue;
+        }
+        if (ring.stopped() || std::chrono::steady_clock::now() - last > std::chrono::seconds(5))
+        {
+            std::cerr << "RingError: no response from the compiler for " << sent - printed << " statements." << std::endl;
+            return 1;
+        }
+        ShmRing::backoff(idle);
+    }
+    std::cout << std::flush;
+    if (unexpected)
+        std::cerr << "RingError: " << unexpected << " responses did not match a statement sent." << std::endl;
+    if (exitSeen)
+        while (!ring.submit(sent, "exit", 4) && !ring.stopped())
+            std::this_thread::yield();
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    // Command line : [--names] [--limits] [--balance] [--check | --run [threads] [--state <base> | --exact] | --native | --variants [threads]
+    //                                                 | --lex-parallel [threads] | --export <json|sexpr|dot>
+    //                                                 | --shm <name> [threads] | --shm-client <name>]
+    SymbolTable symbols;                // Interned identifier names ('a' ... 'z' always there)
+    bool extended = false;              // --names : multi-character identifiers
+    ResourceLimits limits = ResourceLimits::untrusted();
+    bool limited = false;               // --limits : per-statement budget for untrusted input
+    const char *statePath = nullptr;    // --state <base> : persistent variables (--run)
+    bool exact = false;                 // --exact : arbitrary precision instead of wrap around (--run)
+    bool balance = false;               // --balance : rebalance + - * chains to logarithmic height
+    const char *modeArg = "";           // --shm / --shm-client <name> : shared-memory ring, --export <format>
+    const char *mode = "";
+    unsigned threads = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--names") == 0)
+            extended = true;
+        else if (std::strcmp(argv[i], "--limits") == 0)
+            limited = true;
+        else if (std::strcmp(argv[i], "--state") == 0 && i + 1 < argc)
+            statePath = argv[++i];
+        else if (std::strcmp(argv[i], "--exact") == 0)
+            exact = true;
+        else if (std::strcmp(argv[i], "--balance") == 0)
+            balance = true;
+        else if ((std::strcmp(argv[i], "--shm") == 0 || std::strcmp(argv[i], "--shm-client") == 0 || std::strcmp(argv[i], "--export") == 0) && i + 1 < argc)
+        {
+            mode = argv[i];
+            modeArg = argv[++i];
+        }
+        else if (argv[i][0] == '-')
+            mode = argv[i];
+        else
+            threads = (unsigned)std::atoi(argv[i]);
+    }
+    traceFile = std::getenv("COMPY_TRACE");
+    if (traceFile)
+    {
+        const char *every = std::getenv("COMPY_TRACE_SAMPLE");
+        Trace::enable(every ? (unsigned)std::atoi(every) : 1);
+        std::atexit(writeTrace);
+    }
+    if (std::strcmp(mode, "--check") == 0)
+        return checkOnly(extended);
+    if (std::strcmp(mode, "--run") == 0)
+        return runProgram(threads, symbols, extended, limited ? &limits : nullptr, statePath, exact, balance);
+    if (std::strcmp(mode, "--export") == 0)
+        return exportTrees(modeArg, symbols, extended);
+    if (std::strcmp(mode, "--lex-parallel") == 0)
+        return lexParallel(threads, symbols, extended);
+    if (std::strcmp(mode, "--native") == 0)
+        return runNative(symbols, extended, limited ? &limits : nullptr, balance);
+    if (std::strcmp(mode, "--variants") == 0)
+        return runVariants(threads, symbols, extended, limited ? &limits : nullptr, balance);
+    if (std::strcmp(mode, "--shm") == 0)
+        return serveRing(modeArg, threads, extended);
+    if (std::strcmp(mode, "--shm-client") == 0)
+        return ringClient(modeArg);
+
     system("");             // Help enable ANSI color code
     std::string input;
     int testCount = 0;
@@ -34,16 +670,58 @@ int main()
         testCount++; 
         std::cout << "\033[1;33m\n======================< TEST CASE " << testCount << " >======================\033[0m\n";
 
-        // A. Lexing
+        AllocTrace::beginStatement();                   // Allocation report per statement (-DCOMPY_ALLOC_TRACE build only)
+        Trace::beginStatement();                        // Sampling decision for this statement
+
+        // A. Lexing (Budget clock start here)
         Lexer lexer(input);
-        std::vector<Token> tokens = lexer.tokenize();   // Token List
+        lexer.setSymbolTable(extended ? &symbols : nullptr);
+        if (limited)
+        {
+            limits.start();
+            lexer.setLimits(&limits);
+        }
+        std::vector<Token> tokens;                      // Token List
+        {
+            AllocPhase phase("lex");
+            tokens = lexer.tokenize();
+        }
 
         std::cout << "\033[1;33m";                      // Color Code
-        lexer.printTokenStreamTable(tokens);            // Token Stream Table Print
+        {
+            AllocPhase phase("print");
+            lexer.printTokenStreamTable(tokens);        // Token Stream Table Print
+        }
 
         // B. Parsing
         Parser parser(tokens);
-        bool success = parser.parse();                  // Parse Token
+        parser.setSourceIndex(&lexer.getSourceIndex()); // Report line:column
+        parser.setLimits(limited ? &limits : nullptr);
+        bool success = false;
+        if (!lexer.limitExceeded())                     // Token list dropped by a budget : nothing to parse
+        {
+            AllocPhase phase("parse");
+            success = parser.parse();                   // Parse Token
+        }
+
+        // B.1 Range Analysis (Division that always divide by zero is reported with syntax error)
+        if (success)
+        {
+            AllocPhase phase("analyze");
+            RangeAnalysis ranges;
+            if (!ranges.analyze(parser.getRoot()))
+            {
+                for (const auto &d : ranges.getDiagnostics())
+                    parser.reportError(d.message, d.position);
+            }
+        }
+
+        // B.2 Reassociation (Opt-in, after the diagnostics : tree drawn with the balanced shape)
+        if (balance && success && !parser.hasErrors())
+        {
+            Reassociate chains;
+            chains.run(parser.getRoot());
+        }
 
         // C. Summary (Need to print even if fail - Requirement)
         lexer.summarize();
@@ -72,9 +750,13 @@ int main()
             // Valid syntax
             std::cout << "\033[1;32m---> Valid syntax.\n";
             std::cout << "\033[38;5;121m";                      // Color Code Tree
+            AllocPhase phase("print");
             parser.printSyntaxTree();                           // Print Tree
         }
 
+        std::cout << "\033[0m";
+        AllocTrace::report();                                   // Nothing printed unless built with -DCOMPY_ALLOC_TRACE
+
         std::cout << "\033[38;5;117m\n=======================<COMPLETE>==========================\033[0m\n";
 
     }
@@ -0,0 +1,291 @@
+#include "../include/parallel_executor.hpp"   // Reference to Class header
+#include "../include/trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// 1. Constructor (0 = one worker per core)
+ParallelExecutor::ParallelExecutor(unsigned threadCount) : threads(threadCount)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+// 2. Build read-after-write graph (Statement order is already a topological order : edges only go forward)
+void ParallelExecutor::buildGraph(const std::vector<const Parser::Node *> &stmts)
+{
+    const size_t n = stmts.size();
+    target.assign(n, -1);
+    readBegin.assign(n + 1, 0);
+    readSlot.clear();
+    readFrom.clear();
+
+    std::vector<long> lastWriter(Evaluator::VARIABLE_COUNT, -1);   // Grown for extended names
+    std::vector<size_t> level(n, 0);            // Length of longest chain ending at statement
+    std::vector<size_t> succCount(n, 0);
+    std::vector<const Parser::Node *> stack;
+    std::vector<size_t> reads;
+    stats = Stats();
+    stats.statements = n;
+
+    for (size_t j = 0; j < n; ++j)
+    {
+        readBegin[j] = readSlot.size();
+        const Parser::Node *stmt = stmts[j];
+        const bool assignment = stmt && stmt->type == TokenType::ASSIGNMENT && stmt->left && stmt->left->type == TokenType::IDENTIFIER;
+
+        // A. Variables read by the right-hand side (Each one once)
+        reads.clear();
+        if (assignment && stmt->right)
+            stack.push_back(stmt->right);
+        while (!stack.empty())
+        {
+            const Parser::Node *node = stack.back();
+            stack.pop_back();
+            if (node->type == TokenType::IDENTIFIER)
+                reads.push_back(variableSlot(node));
+            if (node->left)
+                stack.push_back(node->left);
+            if (node->right)
+                stack.push_back(node->right);
+        }
+
+        // B. Edge from the last writer of each variable read
+        std::sort(reads.begin(), reads.end());
+        reads.erase(std::unique(reads.begin(), reads.end()), reads.end());
+        for (size_t slot : reads)
+        {
+            const long producer = slot < lastWriter.size() ? lastWriter[slot] : -1;
+            readSlot.push_back(slot);
+            readFrom.push_back(producer);
+            if (producer >= 0)
+            {
+                ++succCount[producer];
+                ++stats.edges;
+                level[j] = std::max(level[j], level[producer]);
+            }
+        }
+        level[j] += 1;
+        stats.criticalPath = std::max(stats.criticalPath, level[j]);
+
+        // C. Statement become the last writer of its variable
+        if (assignment)
+        {
+            target[j] = (int)variableSlot(stmt->left);
+            if ((size_t)target[j] >= lastWriter.size())
+                lastWriter.resize(target[j] + 1, -1);
+            lastWriter[target[j]] = (long)j;
+        }
+    }
+    readBegin[n] = readSlot.size();
+
+    // D. Successor list (CSR)
+    succBegin.assign(n + 1, 0);
+    for (size_t i = 0; i < n; ++i)
+        succBegin[i + 1] = succBegin[i] + succCount[i];
+    succ.assign(succBegin[n], 0);
+    std::vector<size_t> cursor(succBegin.begin(), succBegin.end() - 1);
+    for (size_t j = 0; j < n; ++j)
+    {
+        for (size_t r = readBegin[j]; r < readBegin[j + 1]; ++r)
+        {
+            if (readFrom[r] >= 0)
+                succ[cursor[readFrom[r]]++] = j;
+        }
+    }
+}
+
+// 3. Run statements on the work-stealing pool, then commit like Evaluator::run
+bool ParallelExecutor::run(const std::vector<const Parser::Node *> &stmts, Evaluator &env)
+{
+    TraceSpan span("parallelRun");
+    const auto begin = std::chrono::steady_clock::now();
+    buildGraph(stmts);
+    const size_t n = stmts.size();
+    if (n == 0)
+        return true;
+
+    const unsigned workers = (unsigned)std::min<size_t>(threads, n);
+    stats.workers = workers;
+
+    // A. Shared run state
+    struct Queue
+    {
+        std::mutex lock;
+        std::deque<size_t> items;   // Owner use front (oldest : close to statement order, tree walked in memory order), thief use back
+    };
+
+    std::vector<long long> result(n, 0);                                // Result cell of each statement
+    std::unique_ptr<std::atomic<size_t>[]> pending(new std::atomic<size_t>[n]);
+    std::unique_ptr<std::atomic<bool>[]> poisoned(new std::atomic<bool>[n]);   // Failed, or read from a failed statement
+    std::atomic<size_t> firstFailure(n);                                // Lowest statement with runtime error
+    std::atomic<size_t> remaining(n);
+    std::atomic<size_t> steals(0);
+    std::atomic<uint64_t> workNs(0);
+    std::vector<Queue> queues(workers);
+
+    for (size_t j = 0; j < n; ++j)
+    {
+        size_t producers = 0;
+        for (size_t r = readBegin[j]; r < readBegin[j + 1]; ++r)
+            producers += (readFrom[r] >= 0);
+        pending[j].store(producers, std::memory_order_relaxed);
+        poisoned[j].store(false, std::memory_order_relaxed);
+        if (producers == 0)
+            queues[j % workers].items.push_back(j); // Spread initial ready statements
+    }
+
+    // B. Worker loop
+    const TraceTask task = Trace::task();   // Worker spans belong to the caller's statement
+    auto worker = [&](unsigned self)
+    {
+        Trace::adopt(task);
+        TraceSpan span("parallelWorker");
+        Evaluator local;            // Private environment : only the variables the statement reads are set
+        size_t localSteals = 0;
+
+        // Busy time = lifetime - idle spans (Clock only read when switching busy <-> idle, not per statement)
+        const auto born = std::chrono::steady_clock::now();
+        auto idleSince = born;
+        bool idle = false;
+        uint64_t idleNs = 0;
+
+        while (remaining.load(std::memory_order_acquire) > 0)
+        {
+            // B.1 Own deque first, then steal from the others
+            size_t j = 0;
+            bool found = false;
+            {
+                std::lock_guard<std::mutex> guard(queues[self].lock);
+                if (!queues[self].items.empty())
+                {
+                    j = queues[self].items.front();
+                    queues[self].items.pop_front();
+                    found = true;
+                }
+            }
+            for (unsigned k = 1; !found && k < workers; ++k)
+            {
+                Queue &victim = queues[(self + k) % workers];
+                std::lock_guard<std::mutex> guard(victim.lock);
+                if (!victim.items.empty())
+                {
+                    j = victim.items.back();
+                    victim.items.pop_back();
+                    found = true;
+                    ++localSteals;
+                }
+            }
+            if (!found)
+            {
+                if (!idle)
+                {
+                    idle = true;
+                    idleSince = std::chrono::steady_clock::now();
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            if (idle)
+            {
+                idle = false;
+                idleNs += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - idleSince).count();
+            }
+
+            // B.2 Execute (Skipped when already after a failure, or an input failed)
+            bool failed = j > firstFailure.load(std::memory_order_relaxed);
+            for (size_t r = readBegin[j]; r < readBegin[j + 1] && !failed; ++r)
+            {
+                const long from = readFrom[r];
+                if (from >= 0 && poisoned[from].load(std::memory_order_acquire))
+                    failed = true;
+                else
+                    local.set(readSlot[r], from >= 0 ? result[from] : env.get(readSlot[r]));    // env is only read until the commit
+            }
+
+            if (!failed)
+            {
+                if (local.execute(stmts[j]))
+                    result[j] = local.get((size_t)target[j]);
+                else
+                {
+                    failed = true;
+                    size_t seen = firstFailure.load(std::memory_order_relaxed);
+                    while (j < seen && !firstFailure.compare_exchange_weak(seen, j, std::memory_order_relaxed))
+                    {
+                    }
+                }
+            }
+            if (failed)
+                poisoned[j].store(true, std::memory_order_release);
+
+            // B.3 Release successors (Last producer to finish schedule it on its own deque)
+            for (size_t s = succBegin[j]; s < succBegin[j + 1]; ++s)
+            {
+                const size_t next = succ[s];
+                if (pending[next].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    std::lock_guard<std::mutex> guard(queues[self].lock);
+                    queues[self].items.push_back(next);
+                }
+            }
+            remaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (idle)
+            idleNs += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now - idleSince).count();
+        const uint64_t lifetime = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now - born).count();
+        workNs.fetch_add(lifetime > idleNs ? lifetime - idleNs : 0, std::memory_order_relaxed);
+        steals.fetch_add(localSteals, std::memory_order_relaxed);
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned w = 1; w < workers; ++w)
+        pool.emplace_back(worker, w);
+    worker(0); // Calling thread is worker 0
+    for (auto &t : pool)
+        t.join();
+    stats.wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    stats.workMs = (double)workNs.load() / 1e6;
+    stats.steals = steals.load();
+
+    // C. Commit in statement order up to the first failure (Later write win, same as sequential)
+    const size_t stop = firstFailure.load();
+    for (size_t j = 0; j < stop; ++j)
+    {
+        if (target[j] >= 0)
+            env.set((size_t)target[j], result[j]);
+    }
+    stats.runMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    // D. Failure : run the failing statement on env so the same runtime error is logged there
+    if (stop < n)
+    {
+        env.execute(stmts[stop]);
+        return false;
+    }
+    return true;
+}
+
+// 4. Print graph + run summary
+void ParallelExecutor::printStats() const
+{
+    char line[160];
+    std::snprintf(line, sizeof(line), "Statements: %zu, dependencies: %zu, critical path: %zu (parallelism %.1fx)",
+                  stats.statements, stats.edges, stats.criticalPath, stats.parallelism());
+    std::cout << line << std::endl;
+    std::snprintf(line, sizeof(line), "Workers: %u, steals: %zu, work %.3f ms, wall %.3f ms (busy %.2fx)",
+                  stats.workers, stats.steals, stats.workMs, stats.wallMs, stats.busy());
+    std::cout << line << std::endl;
+    std::snprintf(line, sizeof(line), "Parallel run %.3f ms (Graph build + workers + commit)", stats.runMs);
+    std::cout << line << std::endl;
+}
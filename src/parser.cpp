@@ -1,4 +1,5 @@
 #include "../include/parser.hpp"
+#include "../include/trace.hpp"
 #include <iostream>
 #include <queue>
 #include <cmath>
@@ -11,38 +12,126 @@
 // 1. Construct New parser
 Parser::Parser(const std::vector<Token> &toks) : tokens(toks), pos(0), errorOccurred(false) {}
 
-// 2. Differentiate type of Token (For Precedence)
-static inline bool isAddSubOp(const std::string &s) { return s == "+" || s == "-"; }
-static inline bool isMulDivOp(const std::string &s) { return s == "*" || s == "/"; }
-
-// 3. Check validity for Token start
-static inline bool isFactorStart(const Token &t)
+// 2. Token Kind bits (Used to build FIRST / FOLLOW synchronization sets)
+enum : unsigned
+{
+    K_ID      = 1u << 0,    // IDENTIFIER
+    K_NUM     = 1u << 1,    // NUMBER
+    K_ADD     = 1u << 2,    // '+'
+    K_SUB     = 1u << 3,    // '-' (Also unary minus at operand position)
+    K_MUL     = 1u << 4,    // '*' '/' '%'
+    K_POW     = 1u << 5,    // '^'
+    K_ASSIGN  = 1u << 6,    // '='
+    K_LPAREN  = 1u << 7,    // '('
+    K_RPAREN  = 1u << 8,    // ')'
+    K_SEMI    = 1u << 9,    // ';'
+    K_INVALID = 1u << 10,   // Lexical error (already reported by Lexer)
+    K_END     = 1u << 11    // End of token list
+};
+
+// 2.1 Grammar sets | FIRST(<factor>) = FIRST(<term>) = FIRST(<expr>)
+static const unsigned FIRST_FACTOR  = K_ID | K_NUM | K_LPAREN | K_SUB;
+static const unsigned FOLLOW_EXPR   = K_RPAREN | K_SEMI | K_END;
+static const unsigned FOLLOW_TERM   = K_ADD | K_SUB | FOLLOW_EXPR;
+static const unsigned BINARY_OP     = K_ADD | K_SUB | K_MUL | K_POW;
+
+// 2.2 Operator table (Index by OpKind) | Higher precedence bind tighter
+struct OpInfo
+{
+    int precedence;
+    bool rightAssoc;
+    bool zeroDivisor;       // Literal 0 right operand is a division by zero
+};
+
+static const OpInfo OPERATORS[] = {
+    {1, false, false},      // +
+    {1, false, false},      // -
+    {2, false, false},      // *
+    {2, false, true},       // /
+    {2, false, true},       // %
+    {3, true,  false},      // ^
+    {0, false, false}       // Not an operator
+};
+
+static const int TERM_PRECEDENCE  = 2;  // Level of the old <term> : error check + panic after it
+static const int UNARY_PRECEDENCE = 3;  // Operand of unary '-' : -a^b = -(a^b), -a*b = (-a)*b
+
+// 3. Kind bit of a Token
+static unsigned kindOf(const Token &t)
 {
-    return t.type == TokenType::IDENTIFIER || t.type == TokenType::NUMBER || t.value == "(";
+    switch (t.type)
+    {
+    case TokenType::IDENTIFIER:           return K_ID;
+    case TokenType::NUMBER:               return K_NUM;
+    case TokenType::OPERATOR:
+        switch (t.op)
+        {
+        case OpKind::ADD: return K_ADD;
+        case OpKind::SUB: return K_SUB;
+        case OpKind::POW: return K_POW;
+        default:          return K_MUL;
+        }
+    case TokenType::ASSIGNMENT:           return K_ASSIGN;
+    case TokenType::LEFT_PAREN:           return K_LPAREN;
+    case TokenType::RIGHT_PAREN:          return K_RPAREN;
+    case TokenType::STATEMENT_TERMINATOR: return K_SEMI;
+    default:                              return K_INVALID;
+    }
 }
 
-// 4. Check if Tree have error Nodes
+// 3.1 Kind bit of current Token (K_END when no more Token)
+unsigned Parser::peekKind() const { return pos < tokens.size() ? kindOf(tokens[pos]) : K_END; }
+
+// 4. Check if Tree have error Nodes (Explicit stack : long operator chain would overflow recursion)
 static bool containsErrorNode(const Parser::Node *node)
 {
-    if (!node)
-        return false;
-    if (node->value == "error")
-        return true;
-    return containsErrorNode(node->left) || containsErrorNode(node->right);
+    std::vector<const Parser::Node *> stack;
+    if (node)
+        stack.push_back(node);
+    while (!stack.empty())
+    {
+        const Parser::Node *n = stack.back();
+        stack.pop_back();
+        if (n->value == "error")
+            return true;
+        if (n->left)
+            stack.push_back(n->left);
+        if (n->right)
+            stack.push_back(n->right);
+    }
+    return false;
 }
 
 // 5. Error handling Function (Need to error handle before reading)
 void Parser::reportError(const std::string &msg) { reportError(msg, -1); }
 
-// 5.1 Log error with position (Overload)
+// 5.1 Log error with position (Overload) : Nothing after a LimitError, LimitError once the diagnostic budget is spent
 void Parser::reportError(const std::string &msg, int position)
 {
-    std::string where = (position >= 0 ? std::to_string(position) : "end");
-    std::string full = "SyntaxError at position " + where + ": " + msg;
-    errorMessages.push_back(full);
+    if (limitExceeded())
+        return;
+    if (limits && limits->maxDiagnostics && errorMessages.size() >= limits->maxDiagnostics)
+    {
+        exceedLimit(ResourceLimits::Kind::DIAGNOSTICS);
+        return;
+    }
+    errorMessages.push_back(formatError(msg, position, index));
     errorOccurred = true;
 }
 
+// 5.1.1 Message text of a syntax error (Shared with Recognizer so both report the same line)
+std::string Parser::formatError(const std::string &msg, int position, const SourceIndex *index)
+{
+    std::string where;
+    if (position < 0)
+        where = "position end";
+    else if (index)
+        where = index->describe((size_t)position);
+    else
+        where = "position " + std::to_string(position);
+    return "SyntaxError at " + where + ": " + msg;
+}
+
 // 5.2 Print Logged Error
 void Parser::printErrors() const
 {
@@ -53,15 +142,116 @@ void Parser::printErrors() const
 // 5.3 Check Error Log
 bool Parser::hasErrors() const { return !errorMessages.empty(); }
 
+// 5.4 Panic-mode error : Only the first error is logged until a Token is matched again (No cascade)
+void Parser::syntaxError(const std::string &msg, int position)
+{
+    if (panicMode)
+        return;
+    reportError(msg, position);
+    panicMode = true;
+}
+
+// 5.5 Skip Token until one in the FOLLOW set (Nested parentheses are skipped as a whole, ';' always stops)
+void Parser::synchronize(unsigned followSet)
+{
+    TraceSpan span("recover");
+    int depth = 0;
+    while (pos < tokens.size())
+    {
+        unsigned k = kindOf(tokens[pos]);
+        if (k == K_SEMI || (depth == 0 && (k & followSet)))
+            return;
+        if (k == K_LPAREN)
+            ++depth;
+        else if (k == K_RPAREN)
+            --depth;
+        ++pos;
+    }
+}
+
+// 5.6 Budget ran out : Log LimitError and jump to end of Token (Every routine then unwind as "end of input", quietly)
+void Parser::exceedLimit(ResourceLimits::Kind kind)
+{
+    if (limitExceeded())
+        return;
+    exceeded = kind;
+    errorMessages.push_back(limits->message(kind));
+    errorOccurred = true;
+    panicMode = true;
+    pos = tokens.size();
+}
+
+// 5.7 Enter '(' , unary '-' or '^' operand (Recursion depth of the Parser follow this nesting)
+bool Parser::enterNested()
+{
+    if (limits && limits->maxDepth && depth >= limits->maxDepth)
+    {
+        exceedLimit(ResourceLimits::Kind::DEPTH);
+        return false;
+    }
+    ++depth;
+    return true;
+}
+
+// 5.8 New Node owned by the Parser (Node budget checked every Node, clock every 256)
+Parser::Node *Parser::makeNode(const std::string &val, TokenType t, Node *l, Node *r, int p)
+{
+    if (limits)
+    {
+        if (limits->maxNodes && nodes.size() >= limits->maxNodes)
+            exceedLimit(ResourceLimits::Kind::NODES);
+        else if (limits->timeoutMs && (nodes.size() & 255) == 255 && limits->expired())
+            exceedLimit(ResourceLimits::Kind::DEADLINE);
+    }
+    nodes.emplace_back(val, t, l, r, p);    // Still built : caller link it while unwinding
+    return &nodes.back();
+}
+
+// 5.9 Skip invalid Token (Lexer already report them)
+void Parser::skipInvalid()
+{
+    while (pos < tokens.size() && tokens[pos].type == TokenType::INVALID)
+        ++pos;
+}
+
+// 5.10 Misplaced operator or '=' where a factor start : Report, drop it and try the next Token (Each Token seen once)
+void Parser::skipMisplaced()
+{
+    for (;;)
+    {
+        skipInvalid();
+        unsigned k = peekKind();
+        if (k == K_ADD || k == K_MUL || k == K_POW)
+            syntaxError("missing left operand before the operator  '" + tokens[pos].value + "'", tokens[pos].start_pos);
+        else if (k == K_ASSIGN)
+            syntaxError("chained assignment is not allowed (found '=' in expression).", tokens[pos].start_pos);
+        else
+            break;
+        ++pos;
+    }
+}
+
 // 6. Parsing Function
 // 6.1 If Parsing Succeeded
 bool Parser::parse()
 {
+    TraceSpan span("parse");
     // Reset state
     errorMessages.clear();
     errorOccurred = false;
+    panicMode = false;
     root = nullptr;
     pos = 0;
+    depth = 0;
+    exceeded = ResourceLimits::Kind::NONE;
+    std::deque<Node>().swap(nodes); // Tree of previous parse() released
+
+    // Token budget (Token list may come from a Lexer without budget, e.g. Program split)
+    if (limits && limits->maxTokens && tokens.size() > limits->maxTokens)
+    {
+        exceedLimit(ResourceLimits::Kind::TOKENS);
+        return false;
+    }
 
     // Check for empty input (accidently press enter)
     if (tokens.empty())
@@ -81,22 +271,22 @@ bool Parser::parse()
             reportError("more expressions found after ';' (only one statement allowed).", tokens[pos].start_pos);
         }
 
+        panicMode = false; // Each statement get its own first diagnostic
         Node *stmtRoot = parseStatement();
         if (!root && stmtRoot) // keep the first valid tree only
             root = stmtRoot;
 
-        // Check for statement terminator
-        if (pos < tokens.size() && tokens[pos].value == ";")
+        // Check for statement terminator (FOLLOW(<stmt>) = ';')
+        if (peekKind() == K_SEMI)
         {
             ++pos; // consume ';'
         }
         else
         {
-            // Missing semicolon
-            int p = (pos < (int)tokens.size() ? tokens[pos].start_pos : -1);
+            // Missing semicolon : continue from where the statement stopped until ';'
+            int p = (pos < tokens.size() ? (int)tokens[pos].start_pos : -1);
             reportError("missing statement terminator ';'.", p);
-            while (pos < tokens.size() && tokens[pos].value != ";")
-                ++pos;
+            synchronize(K_SEMI);
             if (pos < tokens.size())
                 ++pos;
         }
@@ -104,6 +294,18 @@ bool Parser::parse()
         firstStatement = false; // Next statement triggers "more expressions" error
     }
 
+    // Tree height is the recursion depth of every later pass (Long operator chain is deep without any '(')
+    if (limits && limits->maxDepth && !limitExceeded() && getTreeHeight(root) > (int)limits->maxDepth)
+        exceedLimit(ResourceLimits::Kind::DEPTH);
+
+    // Budget ran out : drop the partial tree (Memory back now, not when the Parser die)
+    if (limitExceeded())
+    {
+        root = nullptr;
+        std::deque<Node>().swap(nodes);
+        return false;
+    }
+
     bool treeHasError = containsErrorNode(root);
     return !hasErrors() && !treeHasError && root != nullptr;
 }
@@ -111,53 +313,46 @@ bool Parser::parse()
 // 6.2 The rules (Grammar) | [ <stmt> -> id = <expr> ; ]
 Parser::Node *Parser::parseStatement()
 {
+    TraceSpan span("parseStatement");
     Node *left = nullptr;
 
-    bool validStart = true;
-
     // A. Need an Identifier at start
-    if (pos >= tokens.size() || tokens[pos].type != TokenType::IDENTIFIER)
-    {
-        reportError("statement must start with an identifier, cannot start with '" + tokens[pos].value + "'", tokens[pos].start_pos);
-        left = new Node("error_id", TokenType::INVALID);
-        validStart = false;   // <--- mark invalid start
-    }
-    else
+    if (peekKind() != K_ID)
     {
-        left = new Node(tokens[pos].value, TokenType::IDENTIFIER);
-        ++pos;
-    }
+        syntaxError("statement must start with an identifier, cannot start with '" + tokens[pos].value + "'", tokens[pos].start_pos);
+        left = makeNode("error_id", TokenType::INVALID);
 
-    // If invalid start, do NOT check for '='
-    // Jump straight to parsing the expression (best-effort recovery)
-    if (!validStart)
-    {
-        // Try to continue by parsing expression directly
-        Node* right = parseExpr();
+        // If invalid start, do NOT check for '='
+        // Jump straight to parsing the expression (best-effort recovery)
+        Node *right = parseExpr();
         if (!right)
-            right = new Node("error", TokenType::INVALID);
+            right = makeNode("error", TokenType::INVALID);
 
-        return new Node("=", TokenType::ASSIGNMENT, left, right);
+        return makeNode("=", TokenType::ASSIGNMENT, left, right);
     }
 
+    left = makeNode(tokens[pos].value, TokenType::IDENTIFIER, nullptr, nullptr, (int)tokens[pos].start_pos);
+    left->symbol = tokens[pos].symbol;
+    ++pos;
 
     // B. Assignment Operator After Identifier
-    if (pos >= tokens.size() || tokens[pos].value != "=")
+    int assignPos = (pos < tokens.size() ? (int)tokens[pos].start_pos : -1);
+    if (peekKind() != K_ASSIGN)
     {
         if (pos < tokens.size())
-            reportError("missing '=' after identifier before '" + tokens[pos].value + "'", tokens[pos].start_pos);
+            syntaxError("missing '=' after identifier before '" + tokens[pos].value + "'", tokens[pos].start_pos);
         else
-            reportError("missing '=' after identifier.");
+            syntaxError("missing '=' after identifier.", -1);
 
-        // Skip Token
-        if (pos < tokens.size())
+        // Skip Token (unless it already belong to FOLLOW(<stmt>))
+        if (pos < tokens.size() && peekKind() != K_SEMI)
             ++pos;
     }
     else // Continue to check if "==" occur
     {
-        if ((pos + 1) < tokens.size() && tokens[pos + 1].value == "=")
+        if ((pos + 1) < tokens.size() && tokens[pos + 1].type == TokenType::ASSIGNMENT)
         {
-            reportError("extra assignment '==' is not allowed.", tokens[pos].start_pos);
+            syntaxError("extra assignment '==' is not allowed.", tokens[pos].start_pos);
             pos += 2; // Skip both "==" because it has different meaning (Same as)
         }
         else
@@ -167,215 +362,214 @@ Parser::Node *Parser::parseStatement()
     }
 
     // C. Check for missing right-hand expression (Only report if nothing to parse after '=')
-    if (pos >= tokens.size() || tokens[pos].value == ";")
+    if (peekKind() & (K_SEMI | K_END))
     {
-        reportError("missing right-hand expression after '='.", (pos < tokens.size() ? tokens[pos].start_pos : -1));
+        syntaxError("missing right-hand expression after '='.", (pos < tokens.size() ? (int)tokens[pos].start_pos : -1));
     }
 
     // D. Parse the right-hand Expression
     Node *right = parseExpr();
     if (!right)
-        right = new Node("error", TokenType::INVALID);
+        right = makeNode("error", TokenType::INVALID);
 
     // Return the assignment Node
-    return new Node("=", TokenType::ASSIGNMENT, left, right);
-
+    return makeNode("=", TokenType::ASSIGNMENT, left, right, assignPos);
 }
 
-// 6.3 Addition/Subtraction Expression | [ <expr> -> <term> { ('+' | '-') <term> } ]
+// 6.3 Expression | [ <expr> -> <binary(1)> ]
 Parser::Node *Parser::parseExpr()
 {
-    // Parse the first
-    // Skip invalid tokens before starting expression
-    while (pos < tokens.size() && tokens[pos].type == TokenType::INVALID)
-        ++pos;
-
-    Node *left = parseTerm();
+    Node *left = parseBinary(1);
 
+    // Handle the missing Operand (To create the Error Node and keep structure alive)
+    if (!left)
+        left = makeNode("error", TokenType::INVALID);
+    return left;
+}
 
-    // Handle the missing Operand
+// 6.4 Precedence climbing | [ <binary(p)> -> <factor> { op <binary(q)> } ] for every op with precedence >= p,
+// q = precedence (right associative) or precedence + 1. Level 1 and 2 still stop at FOLLOW(<term>) like before.
+Parser::Node *Parser::parseBinary(int minPrecedence)
+{
+    // Parse the first factor (nullptr mean we are already at FOLLOW(<term>))
+    Node *left = parseFactor();
     if (!left)
-    {
-        // To create the Error Node
-        if (pos < tokens.size() && (tokens[pos].value == "+" || tokens[pos].value == "-"))
-        {
-            reportError("missing operand before '" + tokens[pos].value + "'", tokens[pos].start_pos);
-            left = new Node("error", TokenType::INVALID); // keep structure alive
-            ++pos;
-        }
-        left = new Node("error", TokenType::INVALID);
-    }
+        return nullptr;
 
-    // Loop for + - operator
-    while (pos < tokens.size() && isAddSubOp(tokens[pos].value))
+    for (;;)
     {
-        std::string op = tokens[pos].value;
-        ++pos;
-
-        Node *right = parseTerm();
-        if (!right)
+        // Loop for operator that bind at least as tight as this level
+        while ((peekKind() & BINARY_OP) && OPERATORS[(int)tokens[pos].op].precedence >= minPrecedence)
         {
-            reportError("missing operand after '" + op + "'", tokens[pos - 1].start_pos);
-            right = new Node("error", TokenType::INVALID);
-        }
-
-        // For Building tree node
-        left = new Node(op, TokenType::OPERATOR, left, right);
-    }
+            const Token &t = tokens[pos];
+            const OpInfo &info = OPERATORS[(int)t.op];
+            int opPos = (int)t.start_pos;
+            if (info.rightAssoc)
+            {
+                Node *chain = parseRightChain(left, info.precedence);
+                if (chain == left)
+                    break;          // Depth budget : operator not read
+                left = chain;
+                continue;
+            }
+            ++pos;
 
-    // Loop for error when unexpected tokens
-    while (pos < tokens.size())
-    {
-        const auto &t = tokens[pos];
+            Node *right = parseBinary(info.precedence + 1);
+            // Check for missing operand
+            if (!right)
+            {
+                syntaxError("missing operand after '" + t.value + "'", opPos);
+                right = makeNode("error", TokenType::INVALID);
+            }
 
-        // Stop cleanly if we reach end of expression or statement
-        if (t.value == ")" || t.value == ";")
-            break;
+            // Check for division by 0 (Logical error)
+            if (info.zeroDivisor && right->type == TokenType::NUMBER && right->value == "0")
+            {
+                reportError("division by zero is not allowed.", (int)tokens[pos - 1].start_pos);
+            }
 
-        if (t.type == TokenType::INVALID)
-        {
-            ++pos;
-            continue;
+            // For building Tree Node
+            left = makeNode(t.value, TokenType::OPERATOR, left, right, opPos);
         }
 
-        if (t.value == "=")
-        {
-            reportError("chained assignment is not allowed (found '=' in expression).", t.start_pos);
-            ++pos;
-            continue;
-        }
+        // Operand of '*' '/' '%' '^' : the enclosing level check what follow
+        if (minPrecedence > TERM_PRECEDENCE)
+            return left;
 
-        if (isFactorStart(t))
+        // Unexpected Token : Report the first one, then panic until FOLLOW(<term>)
+        skipInvalid();
+        unsigned k = peekKind();
+        if (!(k & FOLLOW_TERM))
         {
-            // Only flag missing operator if this isn't following a valid operator
-            if (!(pos > 0 && (tokens[pos - 1].type == TokenType::OPERATOR)))
-            {
-                reportError("missing operator before '" + t.value + "'", t.start_pos);
-            }
-            // Don’t consume semicolon or valid factor here
-            ++pos;
-            continue;
+            const auto &t = tokens[pos];
+            if (k == K_ASSIGN)
+                syntaxError("chained assignment is not allowed (found '=' in expression).", t.start_pos);
+            else if (k & FIRST_FACTOR)
+                syntaxError("missing operator before '" + t.value + "'", t.start_pos);
+            synchronize(FOLLOW_TERM);
         }
 
-        // Any other unexpected token
-        ++pos;
+        // Panic stopped on '+' '-' : the expression level carry on, the term level give it back
+        if (minPrecedence > 1 || !(peekKind() & (K_ADD | K_SUB)))
+            return left;
     }
-    return left;
 }
 
-// 6.4 Parses a term (Multiplication/Division) | [ <term> -> <factor> { ('*' | '/') <factor> } ]
-Parser::Node *Parser::parseTerm()
+// 6.5 Right associative chain | [ a ^ b ^ c ] = a ^ (b ^ c) : operands read in a loop, Nodes folded from the right
+// (Same tree and diagnostics as one recursion per operator, without the stack growing with the chain)
+Parser::Node *Parser::parseRightChain(Node *first, int precedence)
 {
-    // Parse the first factor
-    Node *left = nullptr;
-
-    // Skip invalid tokens before starting
-    while (pos < tokens.size() && tokens[pos].type == TokenType::INVALID)
-        ++pos;
-
-    left = parseFactor();
-
-
-    // Loop for * / factor
-    while (pos < tokens.size() && isMulDivOp(tokens[pos].value))
+    std::vector<Node *> operands{first};
+    std::vector<const Token *> ops;
+    while ((peekKind() & BINARY_OP) && OPERATORS[(int)tokens[pos].op].rightAssoc && OPERATORS[(int)tokens[pos].op].precedence == precedence)
     {
-        std::string op = tokens[pos].value;
+        if (!enterNested())
+            break;
+        const Token &t = tokens[pos];
         ++pos;
+        ops.push_back(&t);
 
-        Node *right = parseFactor();
-        // Check for missing operand
+        Node *right = parseBinary(precedence + 1);
         if (!right)
         {
-            reportError("missing operand after '" + op + "'", tokens[pos - 1].start_pos);
-            right = new Node("error", TokenType::INVALID);
+            syntaxError("missing operand after '" + t.value + "'", (int)t.start_pos);
+            operands.push_back(makeNode("error", TokenType::INVALID));
+            break;          // At FOLLOW : nothing more to chain
         }
-
-        // Check for division by 0 (Logical error)
-        if (op == "/" && right && right->type == TokenType::NUMBER && right->value == "0")
-        {
-            reportError("division by zero is not allowed.", tokens[pos - 1].start_pos);
-        }
-
-        // For building Tree Node
-        left = new Node(op, TokenType::OPERATOR, left, right);
+        operands.push_back(right);
     }
 
-    // Loop for error when unexpected Token
-    while (pos < tokens.size())
+    Node *node = operands.back();
+    for (size_t i = ops.size(); i-- > 0;)
     {
-        const auto &t = tokens[pos];
-        bool isAdditive = (t.value == "+" || t.value == "-");
-        bool isEnd = (t.value == ")" || t.value == ";");
-        if (isAdditive || isEnd)
-            break;
-
-        // List of Print Error
-        if (t.type == TokenType::INVALID)
-        {
-            //reportError("unexpected token '" + t.value + "'", t.start_pos);
-            ++pos;
-            continue;
-        }
-        else if (t.value == "=")
-        {
-            reportError("chained assignment is not allowed (found '=' in expression).", t.start_pos);
-            ++pos;
-        }
-        else if (isFactorStart(t))
-        {
-            reportError("missing operator before '" + t.value + "'", t.start_pos);
-            parseFactor(); // Parse and discard
-        }
-        else
-        { // Any other unexpected Token
-            //reportError("unexpected token '" + t.value + "'", t.start_pos);
-            ++pos;
-        }
+        leaveNested();
+        node = makeNode(ops[i]->value, TokenType::OPERATOR, operands[i], node, (int)ops[i]->start_pos);
     }
-
-    return left;
+    return node;
 }
 
-// 6.5 Parse a factor (NUM,ID,EXPR) \ [ <factor> -> NUMBER | IDENTIFIER | '(' <expr> ') ]
+// 6.6 Parse a factor (NUM,ID,EXPR) \ [ <factor> -> NUMBER | IDENTIFIER | '-' <factor> | '(' <expr> ') ]
 Parser::Node *Parser::parseFactor()
 {
+    // A. Misplaced operator or '=' : Report, drop it and try the next Token
+    skipMisplaced();
+
     if (pos >= tokens.size())
     {
-        reportError("unexpected end of expression.");
+        syntaxError("unexpected end of expression.", -1);
         return nullptr;
     }
 
     const auto &t = tokens[pos];
 
-    // A. Number or Identifier
+    // B. Number or Identifier
     if (t.type == TokenType::IDENTIFIER || t.type == TokenType::NUMBER)
     {
         ++pos;
-        return new Node(t.value, t.type);
+        panicMode = false; // Matched : resume reporting
+        Node *leaf = makeNode(t.value, t.type, nullptr, nullptr, (int)t.start_pos);
+        leaf->symbol = t.symbol;
+        return leaf;
+    }
+
+    // C. Unary minus | [ <factor> -> '-' <binary(UNARY_PRECEDENCE)> ] (left child is empty)
+    // A run of '-' is read in a loop, not one recursion per '-' ("- - - ... a" cannot overflow the stack) :
+    // the operand of every '-' but the last is the next '-', so only the last one parse <binary(UNARY_PRECEDENCE)>
+    if (t.type == TokenType::OPERATOR && t.op == OpKind::SUB)
+    {
+        std::vector<int> signs;     // Position of each '-' (Outermost first)
+        bool nested = true;
+        do
+        {
+            if (!enterNested())
+            {
+                nested = false;     // Depth budget : this '-' is not read, the one before it has no operand
+                break;
+            }
+            signs.push_back((int)tokens[pos].start_pos);
+            ++pos;
+            skipMisplaced();        // Same recovery as a factor after each '-'
+        } while (peekKind() == K_SUB);
+
+        Node *operand = nested ? parseBinary(UNARY_PRECEDENCE) : nullptr;
+        for (size_t i = signs.size(); i-- > 0;)   // Innermost first
+        {
+            leaveNested();
+            if (!operand)
+            {
+                syntaxError("missing operand after '-'", signs[i]);
+                operand = makeNode("error", TokenType::INVALID);
+            }
+            operand = makeNode("-", TokenType::OPERATOR, nullptr, operand, signs[i]);
+        }
+        return operand;
     }
 
-    // B. Parenthesis
-    if (t.value == "(")
+    // D. Parenthesis
+    if (t.type == TokenType::LEFT_PAREN)
     {
         // Check for empthy Parenthesis
-        if ((pos + 1) < tokens.size() && tokens[pos + 1].value == ")")
+        if ((pos + 1) < tokens.size() && tokens[pos + 1].type == TokenType::RIGHT_PAREN)
         {
-            reportError("empty parenthesis '()' is not a valid factor.", tokens[pos].start_pos);
+            syntaxError("empty parenthesis '()' is not a valid factor.", tokens[pos].start_pos);
             pos += 2; // Discard both and continue
-            return new Node("error", TokenType::INVALID);
+            return makeNode("error", TokenType::INVALID);
         }
 
         // If found then continue
+        if (!enterNested())
+            return nullptr;
         ++pos;
-        Node *expr = parseExpr(); // Parse inner-Expression
+        Node *expr = parseExpr(); // Parse inner-Expression (stop at FOLLOW(<expr>))
+        leaveNested();
 
         // Need to Close Parenthesis
-        if (pos >= tokens.size() || tokens[pos].value != ")")
+        if (peekKind() != K_RPAREN)
         {
             if (pos < tokens.size())
-                reportError("missing closing parenthesis before '" + tokens[pos].value + "'", tokens[pos].start_pos);
+                syntaxError("missing closing parenthesis before '" + tokens[pos].value + "'", tokens[pos].start_pos);
             else
-                reportError("missing closing parenthesis.");
+                syntaxError("missing closing parenthesis.", -1);
             return expr; // Still need to return inner Expression
         }
 
@@ -384,40 +578,30 @@ Parser::Node *Parser::parseFactor()
         return expr;
     }
 
-    // C. Unexpected Token (if found 2 in one after another)
-    if (t.value == "+" || t.value == "-")
-    {
-        reportError("missing left operand before the operator  '" + t.value + "'", t.start_pos);
-        ++pos;
-        return parseFactor(); // Try to parse again
-    }
-
-    if (t.value == "*" || t.value == "/")
-    {
-        reportError("missing left operand before the operator  '" + t.value + "'", t.start_pos);
-        ++pos;
-        return parseFactor(); // Try to parse again
-    }
-
-    // End of expression
-    if (t.value == ")" || t.value == ";")
-    {
-        return nullptr; // To signal missing operand (Refer back)
-    }
-
-    // Catch all error
-    //reportError("unexpected token '" + t.value + "'", t.start_pos);
-    ++pos; //
+    // E. End of expression ')' ';' : To signal missing operand (Refer back)
     return nullptr;
 }
 
 // 7. Tree Printing Function
-// 7.1 Get tree height to estimate the wideness
+// 7.1 Get tree height to estimate the wideness (Explicit stack : long operator chain would overflow recursion)
 int Parser::getTreeHeight(const Node *node) const
 {
-    if (!node)
-        return 0;
-    return 1 + std::max(getTreeHeight(node->left), getTreeHeight(node->right));
+    int height = 0;
+    std::vector<std::pair<const Node *, int>> stack;
+    if (node)
+        stack.emplace_back(node, 1);
+    while (!stack.empty())
+    {
+        const Node *n = stack.back().first;
+        const int level = stack.back().second;
+        stack.pop_back();
+        height = std::max(height, level);
+        if (n->left)
+            stack.emplace_back(n->left, level + 1);
+        if (n->right)
+            stack.emplace_back(n->right, level + 1);
+    }
+    return height;
 }
 
 // 7.2 Build row layout (static)
@@ -658,6 +842,13 @@ void Parser::displayTree() const
         return;
     }
 
+    // Width and row count double with every level : with limits on, only draw what fit on a screen
+    if (limits && d > MAX_DISPLAY_HEIGHT)
+    {
+        std::cout << " <tree too tall to draw : height " << d << ", limit " << MAX_DISPLAY_HEIGHT << ">\n";
+        return;
+    }
+
     // This tree is not empty, so get a list of node values...
     const auto rows_disp = get_row_display();
     // then format these into a text representation...
@@ -674,6 +865,7 @@ void Parser::displayTree() const
 // 8. Print the Tree
 void Parser::printSyntaxTree()
 {
+    TraceSpan span("render");
     if (!root)
     {
         std::cout << "Syntax tree is empty.";
@@ -0,0 +1,157 @@
+#include "../include/persistent_env.hpp"   // Reference to Class header
+#include <algorithm>
+
+std::atomic<size_t> PersistentEnv::nodeCount(0);
+const size_t PersistentEnv::NODE_BYTES = std::max(sizeof(PersistentEnv::Leaf), sizeof(PersistentEnv::Branch));
+
+// 1. Fork / move / destroy (A version own one reference to its root)
+PersistentEnv::PersistentEnv(const PersistentEnv &other) : root(other.root), levels(other.levels) { retain(root); }
+
+PersistentEnv::PersistentEnv(PersistentEnv &&other) noexcept : root(other.root), levels(other.levels)
+{
+    other.root = nullptr;
+    other.levels = 0;
+}
+
+PersistentEnv &PersistentEnv::operator=(PersistentEnv other)
+{
+    std::swap(root, other.root);
+    std::swap(levels, other.levels);
+    return *this;
+}
+
+PersistentEnv::~PersistentEnv() { release(root, levels); }
+
+// 1.1 Drop one reference (Last one free the node, then its children)
+void PersistentEnv::release(Node *node, unsigned level)
+{
+    if (!node || node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+    if (level > 0)
+    {
+        Branch *branch = static_cast<Branch *>(node);
+        for (Node *child : branch->child)
+            release(child, level - 1);
+        delete branch;
+    }
+    else
+        delete static_cast<Leaf *>(node);
+    nodeCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// 1.2 Writable node : count 1 = only this version reach it (Its path is already unshared), else copy it
+PersistentEnv::Node *PersistentEnv::unshare(Node *node, unsigned level)
+{
+    if (node->refs.load(std::memory_order_acquire) == 1)
+        return node;
+
+    Node *copy = nullptr;
+    if (level > 0)
+    {
+        Branch *branch = new Branch();
+        std::copy(std::begin(static_cast<Branch *>(node)->child), std::end(static_cast<Branch *>(node)->child), branch->child);
+        for (Node *child : branch->child)
+            retain(child);
+        copy = branch;
+    }
+    else
+    {
+        Leaf *leaf = new Leaf();
+        std::copy(std::begin(static_cast<Leaf *>(node)->values), std::end(static_cast<Leaf *>(node)->values), leaf->values);
+        copy = leaf;
+    }
+    nodeCount.fetch_add(1, std::memory_order_relaxed);
+    release(node, level); // Other versions keep the original
+    return copy;
+}
+
+// 2. Read (Walk one node per level, missing subtree = all 0)
+long long PersistentEnv::get(size_t slot) const
+{
+    if (slot >= capacity())
+        return 0;
+    const Node *node = root;
+    for (unsigned level = levels; level > 0; --level)
+    {
+        node = static_cast<const Branch *>(node)->child[(slot >> (BITS * level)) & (WIDTH - 1)];
+        if (!node)
+            return 0;
+    }
+    return static_cast<const Leaf *>(node)->values[slot & (WIDTH - 1)];
+}
+
+// 3. Write (Path copy : at most levels + 1 new nodes, none when this version already own the path)
+void PersistentEnv::set(size_t slot, long long value)
+{
+    // A. Grow : old root become child 0 of a new branch (Its reference move with it)
+    if (!root)
+    {
+        root = new Leaf();
+        nodeCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    while (slot >= capacity())
+    {
+        Branch *branch = new Branch();
+        branch->child[0] = root;
+        root = branch;
+        ++levels;
+        nodeCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // B. Walk down, unsharing each node of the path
+    root = unshare(root, levels);
+    Node *node = root;
+    for (unsigned level = levels; level > 0; --level)
+    {
+        Node *&child = static_cast<Branch *>(node)->child[(slot >> (BITS * level)) & (WIDTH - 1)];
+        if (!child)
+        {
+            child = (level == 1) ? static_cast<Node *>(new Leaf()) : static_cast<Node *>(new Branch());
+            nodeCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+            child = unshare(child, level - 1);
+        node = child;
+    }
+    static_cast<Leaf *>(node)->values[slot & (WIDTH - 1)] = value;
+}
+
+// 4. Changes against a base version (Both tree walked side by side, same node = nothing changed below)
+std::vector<std::pair<size_t, long long>> PersistentEnv::changes(const PersistentEnv &base) const
+{
+    std::vector<std::pair<size_t, long long>> out;
+    diff(root, levels, base.root, base.levels, std::max(levels, base.levels), 0, out);
+    return out;
+}
+
+// 4.1 a / b are nodes of true level aLevel / bLevel <= level : a lower node sit under child 0 (Tree grow at the top)
+void PersistentEnv::diff(const Node *a, unsigned aLevel, const Node *b, unsigned bLevel, unsigned level, size_t offset,
+                         std::vector<std::pair<size_t, long long>> &out)
+{
+    if ((!a && !b) || (a == b && aLevel == bLevel))
+        return;
+
+    if (level == 0)
+    {
+        for (size_t i = 0; i < WIDTH; ++i)
+        {
+            const long long va = a ? static_cast<const Leaf *>(a)->values[i] : 0;
+            const long long vb = b ? static_cast<const Leaf *>(b)->values[i] : 0;
+            if (va != vb)
+                out.emplace_back(offset + i, va);
+        }
+        return;
+    }
+
+    auto childAt = [level](const Node *n, unsigned nLevel, size_t i) -> const Node *
+    {
+        if (!n)
+            return nullptr;
+        if (nLevel == level)
+            return static_cast<const Branch *>(n)->child[i];
+        return i == 0 ? n : nullptr;
+    };
+    for (size_t i = 0; i < WIDTH; ++i)
+        diff(childAt(a, aLevel, i), std::min(aLevel, level - 1), childAt(b, bLevel, i), std::min(bLevel, level - 1), level - 1,
+             offset + (i << (BITS * level)), out);
+}
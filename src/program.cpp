@@ -0,0 +1,93 @@
+#include "../include/program.hpp"   // Reference to Class header
+#include "../include/lexer.hpp"
+#include "../include/trace.hpp"
+#include <iostream>
+
+// Constructor Program (Keep copy of the source text)
+Program::Program(const std::string &text, SymbolTable *table) : source(text), symbols(table) {}
+
+// Compile : Tokenize the whole source once, then cut the token list at every ';' and parse each piece
+bool Program::compile()
+{
+    TraceSpan span("compile");
+    units.clear();
+    roots.clear();
+    errors.clear();
+
+    // A. Lexing (whole source at once so positions stay absolute; Token budget per statement, clock for the whole scan)
+    Lexer lexer(source);
+    lexer.setSymbolTable(symbols);
+    if (limited)
+    {
+        limits.start();
+        lexer.setLimits(&limits);
+    }
+    std::vector<Token> tokens = lexer.tokenize();
+    errors = lexer.getLexicalErrors();
+    if (lexer.limitExceeded())
+        return false;   // Token list dropped : only the LimitError
+
+    // B. Split into statements (';' stay with its statement)
+    size_t begin = 0;
+    while (begin < tokens.size())
+    {
+        size_t end = begin;
+        while (end < tokens.size() && tokens[end].type != TokenType::STATEMENT_TERMINATOR)
+            ++end;
+        if (end < tokens.size())
+            ++end; // include ';'
+
+        std::unique_ptr<Unit> unit(new Unit());
+        unit->tokens.assign(tokens.begin() + begin, tokens.begin() + end);
+        units.push_back(std::move(unit));
+        begin = end;
+    }
+
+    // C. Parsing (each statement on its own Parser, own budget : a hostile statement cannot slow the others down)
+    std::vector<Parser::Node *> trees;              // Same trees as roots, writable for the analysis
+    for (auto &unit : units)
+    {
+        unit->parser.reset(new Parser(unit->tokens));
+        unit->parser->setSourceIndex(&lexer.getSourceIndex());
+        if (limited)
+        {
+            limits.start();
+            unit->parser->setLimits(&limits);
+        }
+        if (unit->parser->parse())
+        {
+            roots.push_back(unit->parser->getRoot());
+            trees.push_back(unit->parser->getRoot());
+        }
+        else
+            errors.insert(errors.end(), unit->parser->getErrors().begin(), unit->parser->getErrors().end());
+        unit->parser->setSourceIndex(nullptr);      // Index point into the local Lexer (Messages are already formatted)
+    }
+
+    // D. Range Analysis across statements (Variable range flow from one statement to the next, annotate the trees)
+    ranges = RangeAnalysis();
+    if (!exact && !ranges.analyze(trees))
+    {
+        for (const auto &d : ranges.getDiagnostics())
+            errors.push_back("SyntaxError at " + lexer.getSourceIndex().describe((size_t)d.position) + ": " + d.message);
+    }
+
+    // E. Reassociation (Opt-in, after every diagnostic so they are the ones of the source as written)
+    if (balance && errors.empty())
+    {
+        for (auto &unit : units)
+        {
+            if (unit->parser->getRoot())
+                chains.run(unit->parser->getRoot()); // Root is the '=' Node : never replaced
+        }
+    }
+
+    return errors.empty() && !roots.empty();
+}
+
+// Print combined collected errors
+void Program::printErrors() const
+{
+    for (const auto &err : errors)
+        std::cerr << err << std::endl;
+}
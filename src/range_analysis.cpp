@@ -0,0 +1,236 @@
+#include "../include/range_analysis.hpp"   // Reference to Class header
+#include "../include/evaluator.hpp"        // Variable Slot + Literal value
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <iostream>
+
+typedef __int128 wide;     // Wide enough for any product / quotient of two 64-bit bounds
+
+// 1. Any 64-bit value
+Interval Interval::full() { return Interval{LLONG_MIN, LLONG_MAX}; }
+
+// 1.1 Fit candidate bounds into an Interval : false when any of them overflow 64-bit (out left as is, full)
+static bool fromCandidates(const wide *c, size_t n, Interval &out)
+{
+    if (n == 0)
+        return false;
+    wide lo = c[0], hi = c[0];
+    for (size_t i = 1; i < n; ++i)
+    {
+        lo = std::min(lo, c[i]);
+        hi = std::max(hi, c[i]);
+    }
+    if (lo < (wide)LLONG_MIN || hi > (wide)LLONG_MAX)
+        return false;
+    out = Interval{(long long)lo, (long long)hi};
+    return true;
+}
+
+// 2. Construct Analysis (All variable unknown until assigned)
+RangeAnalysis::RangeAnalysis() : vars(Evaluator::VARIABLE_COUNT, Interval::full()), checks(0), proven(0) {}
+
+// 3. Analyze one assignment [ id = <expr> ; ]
+bool RangeAnalysis::analyze(Parser::Node *stmt)
+{
+    if (!stmt || stmt->type != TokenType::ASSIGNMENT || !stmt->left || stmt->left->type != TokenType::IDENTIFIER)
+        return true; // Nothing to prove on an invalid tree
+
+    const size_t before = diagnostics.size();
+    const Interval value = evaluate(stmt->right);
+    const size_t slot = variableSlot(stmt->left);
+    if (slot >= vars.size())
+        vars.resize(slot + 1, Interval::full()); // Extended name assigned for the first time
+    vars[slot] = value;
+    return diagnostics.size() == before;
+}
+
+// 3.1 Analyze statements in order (Range flow from one statement to the next)
+bool RangeAnalysis::analyze(const std::vector<Parser::Node *> &stmts)
+{
+    bool ok = true;
+    for (auto *stmt : stmts)
+        ok = analyze(stmt) && ok;
+    return ok;
+}
+
+// 4. Range of expression (Post-order, explicit stack : a 200k-term chain must not overflow the call stack)
+Interval RangeAnalysis::evaluate(Parser::Node *root)
+{
+    struct Frame
+    {
+        Parser::Node *node;
+        bool expanded;                          // Children already pushed (Their ranges are on top of operands)
+    };
+    std::vector<Frame> work{{root, false}};
+    std::vector<Interval> operands;             // Range of every finished child, left before right
+
+    while (!work.empty())
+    {
+        const Frame frame = work.back();
+        work.pop_back();
+        Parser::Node *node = frame.node;
+
+        // A. Leaves
+        if (!node)
+        {
+            operands.push_back(Interval::full());
+            continue;
+        }
+        if (node->type == TokenType::NUMBER)
+        {
+            operands.push_back(Interval::exact(compy_arith::parseLiteral(node->value)));
+            continue;
+        }
+        if (node->type == TokenType::IDENTIFIER)
+        {
+            operands.push_back(rangeOf(variableSlot(node)));
+            continue;
+        }
+        if (node->type != TokenType::OPERATOR)
+        {
+            operands.push_back(Interval::full());
+            continue;
+        }
+
+        // B. Operator : children first (Right pushed first so left is done first), unary minus has no left
+        const bool unary = !node->left && node->value[0] == '-';
+        if (!frame.expanded)
+        {
+            work.push_back({node, true});
+            work.push_back({node->right, false});
+            if (!unary)
+                work.push_back({node->left, false});
+            continue;
+        }
+
+        const Interval b = operands.back();
+        operands.pop_back();
+        Interval a = Interval::full();
+        if (!unary)
+        {
+            a = operands.back();
+            operands.pop_back();
+        }
+        operands.push_back(combine(node, a, b));
+    }
+    return operands.back();
+}
+
+// 4.1 Range of one operation from the ranges of its operands : Node is marked proven when its check can never fail
+Interval RangeAnalysis::combine(Parser::Node *node, const Interval &a, const Interval &b)
+{
+    Interval result = Interval::full();
+    bool safe = false;
+    ++checks;
+
+    // A. Unary minus : Negated range, only -LLONG_MIN overflow
+    if (!node->left && node->value[0] == '-')
+    {
+        safe = b.lo != LLONG_MIN;
+        if (safe)
+            result = Interval{-b.hi, -b.lo};
+        node->proven = safe;
+        if (safe)
+            ++proven;
+        return result;
+    }
+
+    // B. Same variable on both side of '-' : always exactly 0 (Both read the same value, whatever its range)
+    const bool sameVariable = node->left->type == TokenType::IDENTIFIER && node->right->type == TokenType::IDENTIFIER &&
+                              variableSlot(node->left) == variableSlot(node->right);
+    if (node->value[0] == '-' && sameVariable)
+    {
+        node->proven = true;
+        ++proven;
+        return Interval::exact(0);
+    }
+
+    // C. Divisor that can only be 0 (Parser already report a literal "0" divisor)
+    if ((node->value[0] == '/' || node->value[0] == '%') && b.lo == 0 && b.hi == 0)
+    {
+        if (!(node->right->type == TokenType::NUMBER && node->right->value == "0"))
+            diagnostics.push_back(Diagnostic{"division by zero is not allowed (divisor is always 0).", node->position});
+        node->proven = false;
+        return result;
+    }
+
+    switch (node->value[0])
+    {
+    // D. + - * : Extremes are at the corners, computed without overflow in 128-bit
+    case '+':
+    {
+        wide c[] = {(wide)a.lo + b.lo, (wide)a.hi + b.hi};
+        safe = fromCandidates(c, 2, result);
+        break;
+    }
+    case '-':
+    {
+        wide c[] = {(wide)a.lo - b.hi, (wide)a.hi - b.lo};
+        safe = fromCandidates(c, 2, result);
+        break;
+    }
+    case '*':
+    {
+        wide c[] = {(wide)a.lo * b.lo, (wide)a.lo * b.hi, (wide)a.hi * b.lo, (wide)a.hi * b.hi};
+        safe = fromCandidates(c, 4, result);
+        break;
+    }
+
+    // E. / : Split divisor into negative and positive part (Truncating division is monotone on each part)
+    case '/':
+    {
+        wide c[8] = {};                         // First n filled
+        size_t n = 0;
+        if (b.lo <= -1)
+        {
+            const long long bl = b.lo, bh = std::min(b.hi, -1LL);
+            c[n++] = (wide)a.lo / bl; c[n++] = (wide)a.lo / bh;
+            c[n++] = (wide)a.hi / bl; c[n++] = (wide)a.hi / bh;
+        }
+        if (b.hi >= 1)
+        {
+            const long long bl = std::max(b.lo, 1LL), bh = b.hi;
+            c[n++] = (wide)a.lo / bl; c[n++] = (wide)a.lo / bh;
+            c[n++] = (wide)a.hi / bl; c[n++] = (wide)a.hi / bh;
+        }
+
+        // LLONG_MIN / -1 show up as 2^63 and fail the fit
+        safe = fromCandidates(c, n, result) && !b.contains(0);
+        break;
+    }
+
+    // F. % : |result| < |divisor| and <= |dividend|, sign follow the dividend (LLONG_MIN % -1 trap natively)
+    case '%':
+    {
+        const wide m = std::max(b.lo < 0 ? -(wide)b.lo : (wide)b.lo, b.hi < 0 ? -(wide)b.hi : (wide)b.hi) - 1;
+        wide c[] = {a.lo < 0 ? std::max((wide)a.lo, -m) : 0, a.hi > 0 ? std::min((wide)a.hi, m) : 0};
+        fromCandidates(c, 2, result);
+        safe = !b.contains(0) && !(a.contains(LLONG_MIN) && b.contains(-1));
+        break;
+    }
+
+    // G. ^ : Folded when both side are known, never proven (Always call the checked power)
+    case '^':
+    {
+        long long v = 0;
+        if (a.lo == a.hi && b.lo == b.hi && compy_arith::pow(a.lo, b.lo, v))
+            result = Interval::exact(v);
+        break;
+    }
+    }
+
+    node->proven = safe;
+    if (safe)
+        ++proven;
+    return result;
+}
+
+// 5. Print percentage of runtime check removed
+void RangeAnalysis::printStats() const
+{
+    const double percent = checks ? 100.0 * (double)proven / (double)checks : 0.0;
+    char line[96];
+    std::snprintf(line, sizeof(line), "Runtime checks removed: %zu / %zu (%.1f%%)", proven, checks, percent);
+    std::cout << line << std::endl;
+}
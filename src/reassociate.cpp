@@ -0,0 +1,131 @@
+#include "../include/reassociate.hpp"  // Reference to Class header
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <utility>
+
+namespace
+{
+    // Binary operator of a chain class (Unary minus has no left operand)
+    bool isAdditive(const Parser::Node *n) { return n->type == TokenType::OPERATOR && n->left && (n->value[0] == '+' || n->value[0] == '-'); }
+    bool isProduct(const Parser::Node *n) { return n->type == TokenType::OPERATOR && n->left && n->value[0] == '*'; }
+}
+
+// 1. Rebalance one statement (Every chain found from the top is rebuilt, then its operands are visited)
+Parser::Node *Reassociate::run(Parser::Node *root)
+{
+    before = std::max(before, height(root));
+
+    work.clear();
+    work.push_back(&root);
+    while (!work.empty())
+    {
+        Parser::Node **slot = work.back();
+        work.pop_back();
+        Parser::Node *node = *slot;
+
+        const bool additive = isAdditive(node);
+        if (additive || isProduct(node))
+        {
+            terms.clear();
+            ops.clear();
+            flatten(slot, additive);
+            if (terms.size() >= 4) // 3 operands or less : already as short as possible
+            {
+                ++chains;
+                operands += terms.size();
+                build(0, terms.size(), false, additive, slot);
+            }
+            else
+            {
+                for (const auto &t : terms) // Kept as is : visit its operands only
+                    work.push_back(t.slot);
+            }
+            continue;
+        }
+
+        if (node->right)
+            work.push_back(&node->right);
+        if (node->left)
+            work.push_back(&node->left);
+    }
+
+    after = std::max(after, height(root));
+    return root;
+}
+
+// 2. Flatten a chain, left to right (Explicit stack; right operand of '-' flip the sign of everything under it)
+void Reassociate::flatten(Parser::Node **slot, bool additive)
+{
+    std::vector<std::pair<Parser::Node **, bool>> stack{{slot, false}};
+    while (!stack.empty())
+    {
+        Parser::Node **at = stack.back().first;
+        const bool negative = stack.back().second;
+        stack.pop_back();
+
+        Parser::Node *node = *at;
+        if (additive ? isAdditive(node) : isProduct(node))
+        {
+            ops.push_back(node);
+            stack.emplace_back(&node->right, negative != (node->value[0] == '-'));
+            stack.emplace_back(&node->left, negative);
+        }
+        else
+            terms.push_back(Operand{node, at, negative});
+    }
+}
+
+// 3. Balanced tree of terms [lo, hi) : value = sum of (+/-) terms, each sign XOR flip (First one is always +)
+// Right half starting with a subtracted term is built flipped under a '-' : L + (-x + y) = L - (x - y)
+void Reassociate::build(size_t lo, size_t hi, bool flip, bool additive, Parser::Node **slot)
+{
+    if (hi - lo == 1)
+    {
+        *slot = terms[lo].node;
+        work.push_back(slot); // Operand may hold chains of its own (Barrier, other class)
+        return;
+    }
+
+    const size_t mid = lo + (hi - lo) / 2;
+    const bool subtract = additive && (terms[mid].negative != flip);
+
+    Parser::Node *op = ops.back();
+    ops.pop_back();
+    if (additive)
+        op->value = subtract ? "-" : "+";
+    op->proven = false;
+    *slot = op;
+
+    build(lo, mid, flip, additive, &op->left);
+    build(mid, hi, flip != subtract, additive, &op->right);
+}
+
+// 4. Height = Nodes on the longest path (Iterative : the tree before the pass is as deep as its longest chain)
+size_t Reassociate::height(const Parser::Node *root)
+{
+    size_t best = 0;
+    std::vector<std::pair<const Parser::Node *, size_t>> stack;
+    if (root)
+        stack.emplace_back(root, 1);
+    while (!stack.empty())
+    {
+        const Parser::Node *node = stack.back().first;
+        const size_t depth = stack.back().second;
+        stack.pop_back();
+        best = std::max(best, depth);
+        if (node->left)
+            stack.emplace_back(node->left, depth + 1);
+        if (node->right)
+            stack.emplace_back(node->right, depth + 1);
+    }
+    return best;
+}
+
+// 5. Print rebuilt chains + height of the tallest statement
+void Reassociate::printStats() const
+{
+    char line[128];
+    std::snprintf(line, sizeof(line), "Reassociation: %zu chains (%zu operands) rebalanced, height %zu -> %zu", chains, operands, before, after);
+    std::cout << line << std::endl;
+}
@@ -0,0 +1,309 @@
+#include "../include/recognizer.hpp"    // Reference to Class header
+#include "../include/lexer.hpp"         // Lexical error message
+#include "../include/parser.hpp"        // Syntax error message
+#include "../include/trace.hpp"
+#include <cctype>
+
+// 1. Token kind (Column of the table) + automaton state (Row of the table)
+namespace
+{
+    enum Kind : unsigned char { ID, NUM, ADD, SUB, MUL, POW, ASSIGN, LPAREN, RPAREN, SEMI, END, KIND_COUNT, INVALID = KIND_COUNT };
+
+    enum State : unsigned char
+    {
+        START,              // Before [ id ]
+        AFTER_ID,           // Before [ = ]
+        AFTER_ASSIGN,       // Operand expected right after '='
+        OPERAND_PAREN,      // Operand expected right after '('
+        OPERAND_OP,         // Operand expected right after an operator
+        OPERATOR,           // Operand done : operator, ')' or ';' expected
+        DONE,               // After ';' : only end of input allowed
+        STATE_COUNT
+    };
+
+    enum Action : unsigned char
+    {
+        A_IDENT,            // Shift identifier            -> AFTER_ID
+        A_ASSIGN,           // Shift '='                   -> AFTER_ASSIGN
+        A_OPERAND,          // Shift NUMBER / IDENTIFIER   -> OPERATOR
+        A_OPERATOR,         // Shift + - * / % ^           -> OPERAND_OP
+        A_NEGATE,           // Shift unary '-'             -> OPERAND_OP
+        A_OPEN,             // Push '('                    -> OPERAND_PAREN
+        A_CLOSE,            // Pop '(' (error when none)
+        A_TERMINATE,        // ';' end statement (error when '(' still open)
+        A_FINISH,           // End of input inside statement
+        A_SILENT,           // Parser build an error Node without message : continue as OPERATOR on same Token
+        A_ACCEPT,
+        A_ERROR             // Report 'error'
+    };
+
+    struct Cell
+    {
+        Action action;
+        Recognizer::Code error;     // Used by A_ERROR
+        bool atPrevious;            // Error reported at the previous Token (operator, '=' or '(')
+    };
+
+    using C = Recognizer::Code;
+    const Cell GO_IDENT = {A_IDENT, C::NONE, false};
+    const Cell GO_ASSIGN = {A_ASSIGN, C::NONE, false};
+    const Cell GO_OPERAND = {A_OPERAND, C::NONE, false};
+    const Cell GO_OPERATOR = {A_OPERATOR, C::NONE, false};
+    const Cell GO_NEGATE = {A_NEGATE, C::NONE, false};
+    const Cell GO_OPEN = {A_OPEN, C::NONE, false};
+    const Cell GO_CLOSE = {A_CLOSE, C::NONE, false};
+    const Cell GO_TERMINATE = {A_TERMINATE, C::NONE, false};
+    const Cell GO_FINISH = {A_FINISH, C::NONE, false};
+    const Cell GO_SILENT = {A_SILENT, C::NONE, false};
+    const Cell GO_ACCEPT = {A_ACCEPT, C::NONE, false};
+    constexpr Cell err(C code, bool atPrevious = false) { return Cell{A_ERROR, code, atPrevious}; }
+
+    // 1.1 Transition table (Same decision, in the same order, as Parser::parse)
+    const Cell TABLE[STATE_COUNT][KIND_COUNT] = {
+        //              ID                         NUM                        ADD                            SUB                            MUL                            POW                            ASSIGN                          LPAREN                      RPAREN                            SEMI                              END
+        /* START */    {GO_IDENT,                  err(C::BAD_START),         err(C::BAD_START),             err(C::BAD_START),             err(C::BAD_START),             err(C::BAD_START),             err(C::BAD_START),              err(C::BAD_START),          err(C::BAD_START),                err(C::BAD_START),                err(C::EMPTY_INPUT)},
+        /* AFTER_ID */ {err(C::MISSING_ASSIGN),    err(C::MISSING_ASSIGN),    err(C::MISSING_ASSIGN),        err(C::MISSING_ASSIGN),        err(C::MISSING_ASSIGN),        err(C::MISSING_ASSIGN),        GO_ASSIGN,                      err(C::MISSING_ASSIGN),     err(C::MISSING_ASSIGN),           err(C::MISSING_ASSIGN),           err(C::MISSING_ASSIGN)},
+        /* AFTER_= */  {GO_OPERAND,                GO_OPERAND,                err(C::MISSING_LEFT_OPERAND),  GO_NEGATE,                     err(C::MISSING_LEFT_OPERAND),  err(C::MISSING_LEFT_OPERAND),  err(C::DOUBLE_ASSIGN, true),    GO_OPEN,                    GO_SILENT,                        err(C::MISSING_RHS),              err(C::MISSING_RHS)},
+        /* AFTER_( */  {GO_OPERAND,                GO_OPERAND,                err(C::MISSING_LEFT_OPERAND),  GO_NEGATE,                     err(C::MISSING_LEFT_OPERAND),  err(C::MISSING_LEFT_OPERAND),  err(C::CHAINED_ASSIGN),         GO_OPEN,                    err(C::EMPTY_PAREN, true),        GO_SILENT,                        err(C::UNEXPECTED_END)},
+        /* AFTER_OP */ {GO_OPERAND,                GO_OPERAND,                err(C::MISSING_LEFT_OPERAND),  GO_NEGATE,                     err(C::MISSING_LEFT_OPERAND),  err(C::MISSING_LEFT_OPERAND),  err(C::CHAINED_ASSIGN),         GO_OPEN,                    err(C::MISSING_OPERAND, true),    err(C::MISSING_OPERAND, true),    err(C::UNEXPECTED_END)},
+        /* OPERATOR */ {err(C::MISSING_OPERATOR),  err(C::MISSING_OPERATOR),  GO_OPERATOR,                   GO_OPERATOR,                   GO_OPERATOR,                   GO_OPERATOR,                   err(C::CHAINED_ASSIGN),         err(C::MISSING_OPERATOR),   GO_CLOSE,                         GO_TERMINATE,                     GO_FINISH},
+        /* DONE */     {err(C::EXTRA_STATEMENT),   err(C::EXTRA_STATEMENT),   err(C::EXTRA_STATEMENT),       err(C::EXTRA_STATEMENT),       err(C::EXTRA_STATEMENT),       err(C::EXTRA_STATEMENT),       err(C::EXTRA_STATEMENT),        err(C::EXTRA_STATEMENT),    err(C::EXTRA_STATEMENT),          err(C::EXTRA_STATEMENT),          GO_ACCEPT},
+    };
+
+    // One scanned Token (Offset into the source, nothing copied)
+    struct Scanned
+    {
+        Kind kind;
+        size_t start;
+        size_t length;
+        char op;            // Operator character
+        bool zero;          // NUMBER is exactly "0"
+    };
+
+    // 2. Scan next Token from pos (Same rules as Lexer::scanRange, extended = Lexer with a SymbolTable)
+    Scanned next(const char *data, size_t size, size_t &pos, bool extended)
+    {
+        while (pos < size && (unsigned char)data[pos] < 0x80 && std::isspace((unsigned char)data[pos]))
+            ++pos;
+        if (pos >= size)
+            return Scanned{END, size, 0, 0, false};
+
+        const size_t start = pos;
+        const unsigned char c = (unsigned char)data[pos];
+
+        if (c >= 0x80)                  // Non-ASCII code point
+        {
+            bool valid = false;
+            size_t len = utf8::decode(data, size, pos, valid);
+            pos += len;
+            return Scanned{INVALID, start, len, 0, false};
+        }
+        if (std::isalpha(c) && extended)    // Extended identifier : letter { letter | digit | '_' }
+        {
+            while (pos < size && (std::isalnum((unsigned char)data[pos]) || data[pos] == '_'))
+                ++pos;
+            return Scanned{ID, start, pos - start, 0, false};
+        }
+        if (std::isalpha(c))            // Identifier (Single lowercase letter)
+        {
+            while (pos < size && std::isalpha((unsigned char)data[pos]))
+                ++pos;
+            const bool ok = (pos - start == 1 && std::islower(c));
+            return Scanned{ok ? ID : INVALID, start, pos - start, 0, false};
+        }
+        if (std::isdigit(c))            // Number
+        {
+            while (pos < size && std::isdigit((unsigned char)data[pos]))
+                ++pos;
+            return Scanned{NUM, start, pos - start, 0, (pos - start == 1 && c == '0')};
+        }
+
+        ++pos;
+        switch (c)
+        {
+        case '+':           return Scanned{ADD, start, 1, (char)c, false};
+        case '-':           return Scanned{SUB, start, 1, (char)c, false};
+        case '*': case '/':
+        case '%':           return Scanned{MUL, start, 1, (char)c, false};
+        case '^':           return Scanned{POW, start, 1, (char)c, false};
+        case '=':           return Scanned{ASSIGN, start, 1, 0, false};
+        case '(':           return Scanned{LPAREN, start, 1, 0, false};
+        case ')':           return Scanned{RPAREN, start, 1, 0, false};
+        case ';':           return Scanned{SEMI, start, 1, 0, false};
+        default:            return Scanned{INVALID, start, 1, 0, false};
+        }
+    }
+
+    Recognizer::Result fail(Recognizer::Code code, int position, size_t length)
+    {
+        Recognizer::Result r;
+        r.valid = false;
+        r.code = code;
+        r.position = position;
+        r.length = length;
+        return r;
+    }
+}
+
+// 3. Run the automaton (Lexical error win over syntax error : main print them first)
+Recognizer::Result Recognizer::check(const char *data, size_t size, bool extended)
+{
+    TraceSpan span("recognize");
+    size_t pos = 0;
+    State state = START;
+    size_t depth = 0;                   // Open '(' (The pushdown stack)
+    bool broken = false;                // Error Node built without message (A_SILENT)
+    Scanned prev = {END, 0, 0, 0, false};
+
+    // Division by zero : '/' or '%' followed by only '(' , the literal 0, then the matching ')' (Parser check the Node, so "(0)" count)
+    // Reported on the next Token unless it is '^' ("a / 0 ^ b" divide by the power, not by 0)
+    bool divisor = false;
+    bool divisorZero = false;
+    size_t divisorOpen = 0;
+    int pendingZero = -1;               // Position of the zero divisor waiting for the next Token
+
+    Result syntax;                      // First syntax error (Lexical error may still come after it)
+    Scanned tok = next(data, size, pos, extended);
+
+    while (syntax.valid)
+    {
+        if (tok.kind == INVALID)
+            return fail(Code::LEXICAL, (int)tok.start, tok.length);
+
+        if (pendingZero >= 0)
+        {
+            if (tok.kind != POW)
+            {
+                syntax = fail(Code::DIVISION_BY_ZERO, pendingZero, 0);
+                break;
+            }
+            pendingZero = -1;
+        }
+
+        const Cell &cell = TABLE[state][tok.kind];
+        const int here = (tok.kind == END) ? -1 : (int)tok.start;
+        bool consume = true;
+
+        switch (cell.action)
+        {
+        case A_IDENT:
+            state = AFTER_ID;
+            break;
+        case A_ASSIGN:
+            state = AFTER_ASSIGN;
+            break;
+        case A_OPERAND:
+            state = OPERATOR;
+            if (divisor && tok.zero)
+            {
+                divisorZero = true;
+                if (divisorOpen == 0)
+                    pendingZero = here;
+            }
+            else
+                divisor = false;
+            break;
+        case A_OPERATOR:
+            state = OPERAND_OP;
+            divisor = (tok.op == '/' || tok.op == '%');
+            divisorZero = false;
+            divisorOpen = 0;
+            break;
+        case A_NEGATE:
+            state = OPERAND_OP;
+            break;
+        case A_OPEN:
+            state = OPERAND_PAREN;
+            ++depth;
+            if (divisor)
+                ++divisorOpen;
+            break;
+        case A_CLOSE:
+            if (depth == 0)
+            {
+                syntax = fail(Code::MISSING_TERMINATOR, here, 0);
+                break;
+            }
+            --depth;
+            if (divisor && divisorZero && --divisorOpen == 0)
+                pendingZero = here;
+            break;
+        case A_TERMINATE:
+            if (depth > 0)
+                syntax = fail(Code::MISSING_CLOSE, here, tok.length);
+            state = DONE;
+            break;
+        case A_FINISH:
+            syntax = fail(depth > 0 ? Code::MISSING_CLOSE : Code::MISSING_TERMINATOR, -1, 0);
+            break;
+        case A_SILENT:
+            broken = true;
+            state = OPERATOR;
+            consume = false;
+            break;
+        case A_ACCEPT:
+            if (broken)
+                return fail(Code::NONE, -1, 0);
+            return Result();
+        case A_ERROR:
+            if (cell.atPrevious)
+                syntax = fail(cell.error, (int)prev.start, prev.length);
+            else
+                syntax = fail(cell.error, here, tok.length);
+            break;
+        }
+
+        if (cell.action != A_OPERAND && cell.action != A_OPEN && cell.action != A_CLOSE)
+            divisor = divisor && cell.action == A_OPERATOR;
+
+        if (consume)
+        {
+            prev = tok;
+            tok = next(data, size, pos, extended);
+        }
+    }
+
+    // 3.1 Syntax error found : rest of the input only matter for a lexical error
+    for (; tok.kind != END; tok = next(data, size, pos, extended))
+    {
+        if (tok.kind == INVALID)
+            return fail(Code::LEXICAL, (int)tok.start, tok.length);
+    }
+    return syntax;
+}
+
+// 4. Diagnostic text (Built here only, check() never allocate)
+std::string Recognizer::message(const std::string &source, const Result &result)
+{
+    if (result.valid || result.code == Code::NONE)
+        return "";
+
+    SourceIndex index(source.data(), source.size());
+    const bool atEnd = result.position < 0;
+    const std::string token = atEnd ? "" : source.substr((size_t)result.position, result.length);
+
+    if (result.code == Code::LEXICAL)
+        return Lexer::lexicalError(index, (size_t)result.position, token);
+
+    std::string text;
+    switch (result.code)
+    {
+    case Code::EMPTY_INPUT:          text = "Empty input."; break;
+    case Code::BAD_START:            text = "statement must start with an identifier, cannot start with '" + token + "'"; break;
+    case Code::MISSING_ASSIGN:       text = atEnd ? "missing '=' after identifier." : "missing '=' after identifier before '" + token + "'"; break;
+    case Code::DOUBLE_ASSIGN:        text = "extra assignment '==' is not allowed."; break;
+    case Code::MISSING_RHS:          text = "missing right-hand expression after '='."; break;
+    case Code::MISSING_LEFT_OPERAND: text = "missing left operand before the operator  '" + token + "'"; break;
+    case Code::CHAINED_ASSIGN:       text = "chained assignment is not allowed (found '=' in expression)."; break;
+    case Code::UNEXPECTED_END:       text = "unexpected end of expression."; break;
+    case Code::EMPTY_PAREN:          text = "empty parenthesis '()' is not a valid factor."; break;
+    case Code::MISSING_OPERAND:      text = "missing operand after '" + token + "'"; break;
+    case Code::MISSING_OPERATOR:     text = "missing operator before '" + token + "'"; break;
+    case Code::MISSING_CLOSE:        text = atEnd ? "missing closing parenthesis." : "missing closing parenthesis before '" + token + "'"; break;
+    case Code::MISSING_TERMINATOR:   text = "missing statement terminator ';'."; break;
+    case Code::DIVISION_BY_ZERO:     text = "division by zero is not allowed."; break;
+    case Code::EXTRA_STATEMENT:      text = "more expressions found after ';' (only one statement allowed)."; break;
+    default: break;
+    }
+    return Parser::formatError(text, result.position, &index);
+}
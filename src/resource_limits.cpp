@@ -0,0 +1,30 @@
+#include "../include/resource_limits.hpp"  // Reference to Class header
+
+// 1. Default budget : far above any hand-written statement, low enough to keep one statement in the millisecond range
+ResourceLimits ResourceLimits::untrusted()
+{
+    ResourceLimits limits;
+    limits.maxTokens = 100000;
+    limits.maxDepth = 2000;
+    limits.maxNodes = 200000;
+    limits.maxDiagnostics = 20;
+    limits.timeoutMs = 250;
+    return limits;
+}
+
+// 2. Start statement clock
+void ResourceLimits::start() { deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs); }
+
+// 3. Diagnostic of a budget that ran out
+std::string ResourceLimits::message(Kind kind) const
+{
+    switch (kind)
+    {
+    case Kind::TOKENS:      return "LimitError: statement has more than " + std::to_string(maxTokens) + " tokens.";
+    case Kind::DEPTH:       return "LimitError: expression is nested deeper than " + std::to_string(maxDepth) + " levels.";
+    case Kind::NODES:       return "LimitError: syntax tree has more than " + std::to_string(maxNodes) + " nodes.";
+    case Kind::DIAGNOSTICS: return "LimitError: more than " + std::to_string(maxDiagnostics) + " errors, checking stopped.";
+    case Kind::DEADLINE:    return "LimitError: time limit of " + std::to_string(timeoutMs) + " ms exceeded.";
+    default:                return "";
+    }
+}
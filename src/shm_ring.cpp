@@ -0,0 +1,331 @@
+#include "../include/shm_ring.hpp"    // Reference to Class header
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// 1. Region layout : header (with one response queue per producer), request slots, MAX_PRODUCERS x response slots
+// (Every atomic is lock-free, so address-free across processes)
+namespace
+{
+    const char RING_MAGIC[8] = {'C', 'O', 'M', 'P', 'Y', 'S', 'H', 'M'};
+    const uint32_t RING_VERSION = 2;
+
+    std::string objectName(const std::string &name) { return (!name.empty() && name[0] == '/') ? name : "/" + name; }
+}
+
+// 1.1 Response ring of one producer : written by every compiler thread, read by its owner only
+struct ShmRing::ResponseQueue
+{
+    alignas(64) std::atomic<uint64_t> tail;             // Next position a compiler thread claim
+    alignas(64) std::atomic<uint64_t> head;             // Next position the owner read
+    alignas(64) std::atomic<uint32_t> owner;            // 1 = attached producer (Claimed by open with one CAS)
+};
+
+struct ShmRing::Header
+{
+    char magic[8];                                      // Written last by create (Region ready)
+    uint32_t version;
+    uint32_t slots;
+    alignas(64) std::atomic<uint64_t> requestTail;      // Next position a producer claim
+    alignas(64) std::atomic<uint64_t> requestHead;      // Next position a compiler thread claim
+    alignas(64) std::atomic<uint32_t> stopping;
+    ResponseQueue queues[ShmRing::MAX_PRODUCERS];
+};
+
+// 1.2 Slot is free for position p when sequence == p, holds the message of position p when sequence == p + 1
+struct alignas(64) ShmRing::RequestSlot
+{
+    std::atomic<uint64_t> sequence;
+    uint64_t id;
+    uint16_t size;
+    uint16_t producer;                                  // Same 256-byte slot as with one response ring
+    char data[SLOT_BYTES];
+};
+
+struct alignas(32) ShmRing::ResponseSlot
+{
+    std::atomic<uint64_t> sequence;
+    uint64_t id;
+    int32_t position;
+    uint32_t length;
+    uint8_t valid;
+    uint8_t code;
+};
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t) && std::atomic<uint64_t>::is_always_lock_free,
+              "ring positions must be plain lock-free words to be shared between processes");
+
+// 1.3 Claim the next position of a ring (Vyukov bounded queue) : false when the ring is full (enqueue) / empty (dequeue)
+template <typename Slot>
+static Slot *claim(std::atomic<uint64_t> &cursor, Slot *slots, uint64_t mask, uint64_t ready, uint64_t &position)
+{
+    position = cursor.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Slot *slot = &slots[position & mask];
+        const int64_t diff = (int64_t)(slot->sequence.load(std::memory_order_acquire) - (position + ready));
+        if (diff == 0)
+        {
+            if (cursor.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                return slot;
+        }
+        else if (diff < 0)
+            return nullptr; // Slot of the previous lap not done yet
+        else
+            position = cursor.load(std::memory_order_relaxed); // Another thread took it
+    }
+}
+
+// 2. Create / open / unmap
+ShmRing::~ShmRing()
+{
+#ifndef _WIN32
+    // Response ring handed back only when empty (A late verdict would reach the next owner otherwise)
+    if (producer < MAX_PRODUCERS && inFlight == 0)
+        header->queues[producer].owner.store(0, std::memory_order_release);
+    if (base)
+        ::munmap(base, bytes);
+#endif
+}
+
+size_t ShmRing::regionBytes(size_t slots) { return sizeof(Header) + slots * (sizeof(RequestSlot) + MAX_PRODUCERS * sizeof(ResponseSlot)); }
+
+bool ShmRing::create(const std::string &name, size_t slots)
+{
+#ifdef _WIN32
+    (void)name; (void)slots;
+    error = "RingError: shared-memory rings need a POSIX system.";
+    return false;
+#else
+    if (slots < 2 || (slots & (slots - 1)) != 0)
+    {
+        error = "RingError: ring size must be a power of 2.";
+        return false;
+    }
+    const std::string path = objectName(name);
+    ::shm_unlink(path.c_str()); // Left by a run that did not finish
+    const int fd = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        error = "RingError: cannot create shared memory " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    const size_t size = regionBytes(slots);
+    if (::ftruncate(fd, (off_t)size) != 0 || !map(fd, size))
+    {
+        if (error.empty())
+            error = "RingError: cannot size shared memory " + path + ": " + std::strerror(errno);
+        ::close(fd);
+        ::shm_unlink(path.c_str());
+        return false;
+    }
+    ::close(fd); // Mapping stay valid after close
+
+    // A. Every slot free for its first-lap position, magic last so open() never see a half-built region
+    header = new (base) Header();
+    header->version = RING_VERSION;
+    header->slots = (uint32_t)slots;
+    layout();
+    for (size_t i = 0; i < slots; ++i)
+        new (&requests[i].sequence) std::atomic<uint64_t>(i);
+    for (size_t i = 0; i < slots * MAX_PRODUCERS; ++i)
+        new (&responses[i].sequence) std::atomic<uint64_t>(i & mask);
+    header->requestTail.store(0, std::memory_order_relaxed);
+    header->requestHead.store(0, std::memory_order_relaxed);
+    header->stopping.store(0, std::memory_order_relaxed);
+    for (ResponseQueue &queue : header->queues)
+    {
+        queue.tail.store(0, std::memory_order_relaxed);
+        queue.head.store(0, std::memory_order_relaxed);
+        queue.owner.store(0, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, RING_MAGIC, sizeof(RING_MAGIC));
+    return true;
+#endif
+}
+
+bool ShmRing::open(const std::string &name)
+{
+#ifdef _WIN32
+    (void)name;
+    error = "RingError: shared-memory rings need a POSIX system.";
+    return false;
+#else
+    const std::string path = objectName(name);
+    const int fd = ::shm_open(path.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        error = "RingError: no compiler is serving " + path + " (start main --shm " + name + " first).";
+        return false;
+    }
+    struct stat st;
+    const bool mapped = ::fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(Header) && map(fd, (size_t)st.st_size);
+    ::close(fd);
+    if (!mapped)
+    {
+        error = "RingError: cannot map shared memory " + path + ".";
+        return false;
+    }
+
+    // A. Same layout as the creator (Magic, version and size agree)
+    header = static_cast<Header *>(base);
+    const size_t slots = header->slots;
+    if (std::memcmp(header->magic, RING_MAGIC, sizeof(RING_MAGIC)) != 0 || header->version != RING_VERSION ||
+        slots < 2 || (slots & (slots - 1)) != 0 || bytes != regionBytes(slots))
+    {
+        error = "RingError: " + path + " is not a COMPY ring (or was made by another version).";
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    layout();
+
+    // B. Own response ring : first free one (Its positions go on from the previous owner, who left it empty)
+    for (uint32_t p = 0; p < MAX_PRODUCERS; ++p)
+    {
+        uint32_t free = 0;
+        if (header->queues[p].owner.compare_exchange_strong(free, 1, std::memory_order_acquire))
+        {
+            producer = p;
+            return true;
+        }
+    }
+    error = "RingError: " + path + " already has " + std::to_string(MAX_PRODUCERS) + " producers.";
+    return false;
+#endif
+}
+
+void ShmRing::unlink(const std::string &name)
+{
+#ifndef _WIN32
+    ::shm_unlink(objectName(name).c_str());
+#else
+    (void)name;
+#endif
+}
+
+bool ShmRing::map(int fd, size_t size)
+{
+#ifdef _WIN32
+    (void)fd; (void)size;
+    return false;
+#else
+    void *p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+        return false;
+    base = p;
+    bytes = size;
+    return true;
+#endif
+}
+
+void ShmRing::layout()
+{
+    static_assert(sizeof(RequestSlot) == 256, "request slot = SLOT_BYTES of text + 20 bytes of fields");
+    mask = header->slots - 1;
+    requests = reinterpret_cast<RequestSlot *>(static_cast<char *>(base) + sizeof(Header));
+    responses = reinterpret_cast<ResponseSlot *>(requests + header->slots);
+}
+
+// 3. Producer : copy statement into a claimed slot, then publish it with the sequence
+// At most one ring of statements in flight : every verdict has room in the response ring of this producer
+bool ShmRing::submit(uint64_t id, const char *text, size_t size)
+{
+    if (producer >= MAX_PRODUCERS || inFlight > mask)
+        return false;
+    uint64_t position = 0;
+    RequestSlot *slot = claim(header->requestTail, requests, mask, 0, position);
+    if (!slot)
+        return false;
+    slot->id = id;
+    slot->producer = (uint16_t)producer;
+    slot->size = (uint16_t)(size < SLOT_BYTES ? size : SLOT_BYTES);
+    std::memcpy(slot->data, text, slot->size);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    ++inFlight;
+    return true;
+}
+
+// 3.1 Response : read fields from the own ring, then hand the slot to the next lap
+bool ShmRing::collect(Response &out)
+{
+    if (producer >= MAX_PRODUCERS)
+        return false;
+    uint64_t position = 0;
+    ResponseSlot *slot = claim(header->queues[producer].head, responses + producer * (mask + 1), mask, 1, position);
+    if (!slot)
+        return false;
+    --inFlight;
+    out.id = slot->id;
+    out.producer = producer;
+    out.result.valid = slot->valid != 0;
+    out.result.code = (Recognizer::Code)slot->code;
+    out.result.position = slot->position;
+    out.result.length = slot->length;
+    slot->sequence.store(position + mask + 1, std::memory_order_release);
+    return true;
+}
+
+// 4. Compiler : statement stay in its slot until release (Producers cannot reuse it meanwhile)
+bool ShmRing::acquire(Request &out)
+{
+    uint64_t position = 0;
+    RequestSlot *slot = claim(header->requestHead, requests, mask, 1, position);
+    if (!slot)
+        return false;
+    out.id = slot->id;
+    out.producer = slot->producer;
+    out.data = slot->data;
+    out.size = slot->size < SLOT_BYTES ? slot->size : SLOT_BYTES;  // Written by another process : never trusted past the slot
+    out.position = position;
+    return true;
+}
+
+void ShmRing::release(const Request &request)
+{
+    requests[request.position & mask].sequence.store(request.position + mask + 1, std::memory_order_release);
+}
+
+bool ShmRing::publish(const Response &response)
+{
+    if (response.producer >= MAX_PRODUCERS)
+        return true;
+    uint64_t position = 0;
+    ResponseSlot *slot = claim(header->queues[response.producer].tail, responses + response.producer * (mask + 1), mask, 0, position);
+    if (!slot)
+        return false;
+    slot->id = response.id;
+    slot->valid = response.result.valid ? 1 : 0;
+    slot->code = (uint8_t)response.result.code;
+    slot->position = response.result.position;
+    slot->length = (uint32_t)response.result.length;
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+// 5. Shutdown flag (Shared : any process can ask)
+void ShmRing::stop() { header->stopping.store(1, std::memory_order_release); }
+
+bool ShmRing::stopped() const { return header->stopping.load(std::memory_order_acquire) != 0; }
+
+// 5.1 Idle wait : spin first (Latency), then yield, then sleep (Idle compiler should not burn a core)
+void ShmRing::backoff(unsigned &idle)
+{
+    ++idle;
+    if (idle < 64)
+        return;
+    if (idle < 1024)
+        std::this_thread::yield();
+    else
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+}
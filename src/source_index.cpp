@@ -0,0 +1,177 @@
+#include "../include/source_index.hpp"  // Reference to Class header
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define COMPY_SSE2 1
+#endif
+
+// 1. Skip ASCII bytes (16 bytes per step with SSE2, 8 bytes per step otherwise)
+size_t utf8::skipAscii(const char *data, size_t size, size_t from)
+{
+    size_t i = from;
+
+#ifdef COMPY_SSE2
+    // Movemask collect the high bit of every byte : zero mean 16 ASCII bytes
+    while (i + 16 <= size)
+    {
+        int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(data + i)));
+        if (mask != 0)
+            return i + __builtin_ctz((unsigned)mask);
+        i += 16;
+    }
+#else
+    while (i + 8 <= size)
+    {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        if (word & 0x8080808080808080ULL)
+            break;
+        i += 8;
+    }
+#endif
+
+    while (i < size && (unsigned char)data[i] < 0x80)
+        ++i;
+    return i;
+}
+
+// 2. Decode one code point (RFC 3629 : reject overlong, surrogate and > U+10FFFF)
+// Invalid sequence return its maximal valid prefix length (at least 1) so each bad code point give one error
+size_t utf8::decode(const char *data, size_t size, size_t at, bool &valid)
+{
+    const unsigned char b0 = (unsigned char)data[at];
+    valid = false;
+
+    if (b0 < 0x80)
+    {
+        valid = true;
+        return 1;
+    }
+
+    // A. Expected length + allowed range of the second byte
+    size_t need;
+    unsigned char lo = 0x80, hi = 0xBF;
+    if (b0 >= 0xC2 && b0 <= 0xDF)       need = 2;
+    else if (b0 == 0xE0)                { need = 3; lo = 0xA0; }
+    else if (b0 == 0xED)                { need = 3; hi = 0x9F; }
+    else if (b0 >= 0xE1 && b0 <= 0xEF)  need = 3;
+    else if (b0 == 0xF0)                { need = 4; lo = 0x90; }
+    else if (b0 == 0xF4)                { need = 4; hi = 0x8F; }
+    else if (b0 >= 0xF1 && b0 <= 0xF3)  need = 4;
+    else
+        return 1; // Continuation byte or invalid lead byte
+
+    // B. Continuation bytes
+    size_t len = 1;
+    while (len < need)
+    {
+        if (at + len >= size)
+            return len;
+        const unsigned char b = (unsigned char)data[at + len];
+        if (b < lo || b > hi)
+            return len;
+        lo = 0x80;
+        hi = 0xBF;
+        ++len;
+    }
+
+    valid = true;
+    return len;
+}
+
+// 3. Construct Source Index (Bitmap is only built on first lookup)
+SourceIndex::SourceIndex(const char *text, size_t length) : data(text), size(length), built(false), cacheValid(false), cacheOffset(0), cacheLine{1, 1} {}
+
+// 3.1 Build newline bitmap + rank of every 64-bit word
+void SourceIndex::build() const
+{
+    const size_t words = size / 64 + 1;    // One spare word so offset == size is still inside
+    newlineBits.assign(words, 0);
+    newlineRank.assign(words + 1, 0);
+
+    size_t i = 0;
+#ifdef COMPY_SSE2
+    const __m128i nl = _mm_set1_epi8('\n');
+    while (i + 16 <= size)
+    {
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i)), nl));
+        newlineBits[i / 64] |= (uint64_t)mask << (i % 64);    // 16 | 64 so never cross a word
+        i += 16;
+    }
+#endif
+    for (; i < size; ++i)
+    {
+        if (data[i] == '\n')
+            newlineBits[i / 64] |= 1ULL << (i % 64);
+    }
+
+    for (size_t w = 0; w < words; ++w)
+        newlineRank[w + 1] = newlineRank[w] + (uint32_t)__builtin_popcountll(newlineBits[w]);
+
+    built = true;
+}
+
+// 3.2 Start of line : nearest newline before offset (Search the bitmap backward, one word at a time)
+size_t SourceIndex::lineStart(size_t offset) const
+{
+    size_t w = offset / 64;
+    uint64_t bits = newlineBits[w] & ((offset % 64) ? (~0ULL >> (64 - offset % 64)) : 0);
+    for (;;)
+    {
+        if (bits)
+            return w * 64 + (63 - __builtin_clzll(bits)) + 1;
+        if (w == 0)
+            return 0;
+        bits = newlineBits[--w];
+    }
+}
+
+// 3.3 Byte offset to line:column
+SourceIndex::Location SourceIndex::locate(size_t offset) const
+{
+    if (offset > size)
+        offset = size;
+    if (!built)
+        build();
+
+    Location loc{1, 1};
+
+    // A. Line = newlines before offset + 1 (rank of the word + popcount inside word)
+    const size_t w = offset / 64;
+    const uint64_t below = (offset % 64) ? (newlineBits[w] & (~0ULL >> (64 - offset % 64))) : 0;
+    loc.line = newlineRank[w] + (size_t)__builtin_popcountll(below) + 1;
+
+    // B. Column = code points between line start and offset + 1 (ASCII runs skipped whole, continuation bytes do not count)
+    // Diagnostics arrive in order, so continue from the previous lookup when it is earlier on the same line
+    size_t start;
+    if (cacheValid && cacheLine.line == loc.line && cacheOffset <= offset)
+    {
+        loc.column = cacheLine.column;
+        start = cacheOffset;
+    }
+    else
+        start = lineStart(offset);
+    for (size_t i = start; i < offset;)
+    {
+        const size_t ascii = utf8::skipAscii(data, offset, i);
+        loc.column += ascii - i;
+        for (i = ascii; i < offset && (unsigned char)data[i] >= 0x80; ++i)
+        {
+            if (((unsigned char)data[i] & 0xC0) != 0x80)
+                ++loc.column;
+        }
+    }
+
+    cacheValid = true;
+    cacheOffset = offset;
+    cacheLine = loc;
+    return loc;
+}
+
+// 3.4 Readable location for diagnostics
+std::string SourceIndex::describe(size_t offset) const
+{
+    Location loc = locate(offset);
+    return "line " + std::to_string(loc.line) + ", column " + std::to_string(loc.column);
+}
@@ -0,0 +1,403 @@
+#include "../include/state_store.hpp"  // Reference to Class header
+#include "../include/trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// 1. File layout (Little endian host order, every field 8-byte aligned)
+namespace
+{
+    const char SNAPSHOT_MAGIC[8] = {'C', 'O', 'M', 'P', 'Y', 'S', 'N', 'P'};
+    const uint32_t SNAPSHOT_VERSION = 1;
+    const uint32_t NAME_RECORD = 0x80000000u;  // Log record flag : new extended name (value = length, bytes follow)
+
+    struct SnapshotHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t headerSize;
+        uint64_t variables;         // Values that follow the header
+        uint64_t names;             // Extended names (id SINGLE_LETTERS ...) : uint32 length each, then the bytes
+        uint64_t nameBytes;
+        uint64_t assignments;       // Assignments applied to reach this state
+        uint64_t checksum;          // Hash of everything after the header
+        uint64_t reserved;
+    };
+
+    struct LogRecord
+    {
+        uint32_t slot;              // Variable slot, or NAME_RECORD | id
+        uint32_t check;             // Low half of hash(slot, value, name bytes) : torn write detection
+        int64_t value;
+    };
+
+    uint32_t recordCheck(const LogRecord &r, const char *name)
+    {
+        uint64_t h = PerfectHash::hash((const char *)&r.slot, sizeof(r.slot), 0x5EED);
+        h = PerfectHash::hash((const char *)&r.value, sizeof(r.value), h);
+        if (name)
+            h = PerfectHash::hash(name, (size_t)r.value, h);
+        return (uint32_t)h;
+    }
+
+    size_t padded(size_t n) { return (n + 7) & ~(size_t)7; }
+
+    // 1.1 Read-only view of a whole file (mmap, read into memory where not available)
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::string &path)
+        {
+#ifdef _WIN32
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+                return;
+            copy.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            data = copy.data();
+            size = copy.size();
+            opened = true;
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                return;
+            struct stat st;
+            if (::fstat(fd, &st) == 0)
+            {
+                opened = true;
+                size = (size_t)st.st_size;
+                if (size > 0)
+                {
+                    void *p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (p != MAP_FAILED)
+                        data = (const char *)p;
+                    else
+                        opened = false;
+                }
+            }
+            ::close(fd); // Mapping stay valid after close
+#endif
+        }
+
+        ~MappedFile()
+        {
+#ifndef _WIN32
+            if (data)
+                ::munmap((void *)data, size);
+#endif
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        bool opened = false;        // File exist and could be read
+        const char *data = nullptr;
+        size_t size = 0;
+
+    private:
+#ifdef _WIN32
+        std::string copy;
+#endif
+    };
+}
+
+// 2. Constructor (Nothing is read until load)
+StateStore::StateStore(const std::string &basePath, SymbolTable *table) : snapPath(basePath + ".snap"), logPath(basePath + ".log"), symbols(table) {}
+
+StateStore::~StateStore()
+{
+    if (log)
+    {
+        flush();
+        std::fclose(log);
+    }
+}
+
+// 3. Load : snapshot, then log on top, then keep the log open for new assignments
+bool StateStore::load(Evaluator &env)
+{
+    TraceSpan span("stateLoad");
+    const auto start = std::chrono::steady_clock::now();
+    error.clear();
+    records = 0;
+    total = 0;
+
+    const bool ok = loadSnapshot(env) && replayLog(env) && openLog("ab");
+    loadTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return ok;
+}
+
+// 3.1 Snapshot : verify header + checksum before touching env (Corrupt file leave env unchanged)
+bool StateStore::loadSnapshot(Evaluator &env)
+{
+    MappedFile file(snapPath);
+    if (!file.opened)
+        return true; // First run : empty state
+
+    SnapshotHeader h;
+    if (file.size < sizeof(h))
+    {
+        error = "snapshot '" + snapPath + "' is truncated.";
+        return false;
+    }
+    std::memcpy(&h, file.data, sizeof(h));
+
+    const uint64_t payload = file.size - sizeof(h);
+    if (std::memcmp(h.magic, SNAPSHOT_MAGIC, sizeof(h.magic)) != 0 || h.version != SNAPSHOT_VERSION || h.headerSize != sizeof(h))
+    {
+        error = "'" + snapPath + "' is not a COMPY snapshot (or a different version).";
+        return false;
+    }
+    if (h.variables > payload / 8 || h.names > (payload - h.variables * 8) / 4 ||
+        h.variables * 8 + h.names * 4 + h.nameBytes != payload ||
+        PerfectHash::hash(file.data + sizeof(h), (size_t)payload, 0) != h.checksum)
+    {
+        error = "snapshot '" + snapPath + "' is corrupt (checksum mismatch).";
+        return false;
+    }
+
+    // A. Names first : symbol id of every extended name must come back the same (Slot = id)
+    const char *lengths = file.data + sizeof(h) + h.variables * 8;
+    const char *bytes = lengths + h.names * 4;
+    for (uint64_t i = 0; i < h.names; ++i)
+    {
+        uint32_t length = 0;
+        std::memcpy(&length, lengths + i * 4, 4);
+        if (!restoreName((uint32_t)(SymbolTable::SINGLE_LETTERS + i), bytes, length))
+            return false;
+        bytes += length;
+    }
+
+    // B. Values (Environment sized once by the last slot)
+    const char *values = file.data + sizeof(h);
+    for (uint64_t i = h.variables; i-- > 0;)
+    {
+        int64_t v = 0;
+        std::memcpy(&v, values + i * 8, 8);
+        env.set((size_t)i, v);
+    }
+    total = h.assignments;
+    return true;
+}
+
+// 3.2 Replay log : a bad record that reach the end of the file is the torn tail of a crash (Cut off so new records
+// follow a good one); a bad record with more data after it is corruption (Reported, file left as it is)
+bool StateStore::replayLog(Evaluator &env)
+{
+    size_t good = 0;
+    {
+        MappedFile file(logPath);
+        if (!file.opened)
+            return true;
+
+        size_t at = 0;
+        bool bad = false;
+        while (at < file.size)
+        {
+            if (file.size - at < sizeof(LogRecord))
+            {
+                bad = true; // Partial record header : only possible at the end
+                at = file.size;
+                break;
+            }
+            LogRecord r;
+            std::memcpy(&r, file.data + at, sizeof(r));
+            size_t next = at + sizeof(r);
+
+            if (r.slot & NAME_RECORD)
+            {
+                const char *name = file.data + next;
+                if (r.value < 0 || (uint64_t)r.value > file.size - next || padded((size_t)r.value) > file.size - next)
+                {
+                    bad = true; // Name run past the end : torn tail
+                    at = file.size;
+                    break;
+                }
+                next += padded((size_t)r.value);
+                if (recordCheck(r, name) != r.check)
+                {
+                    bad = true;
+                    at = next; // Extent of the bad record (Corruption unless it end the file)
+                    break;
+                }
+                if (!restoreName(r.slot & ~NAME_RECORD, name, (size_t)r.value))
+                    return false;
+            }
+            else
+            {
+                if (recordCheck(r, nullptr) != r.check)
+                {
+                    bad = true;
+                    at = next;
+                    break;
+                }
+                env.set(r.slot, r.value);
+                ++records;
+                ++total;
+            }
+            at = next;
+            good = at;
+        }
+
+        if (!bad)
+            return true;
+        if (at < file.size)
+        {
+            error = "log '" + logPath + "' is corrupt at byte " + std::to_string(good) + " (bad record followed by " +
+                    std::to_string(file.size - at) + " more bytes); not truncated, move it away to start from the snapshot.";
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::resize_file(logPath, good, ec);
+    if (ec)
+    {
+        error = "cannot repair log '" + logPath + "': " + ec.message();
+        return false;
+    }
+    return true;
+}
+
+// 3.3 Name from disk must get the id it had when it was saved
+bool StateStore::restoreName(uint32_t id, const char *text, size_t length)
+{
+    if (!symbols)
+    {
+        error = "state has multi-character names (run with --names).";
+        return false;
+    }
+    if (symbols->intern(text, length) != id)
+    {
+        error = "state names do not match this program's symbol table.";
+        return false;
+    }
+    loggedNames = std::max<uint32_t>(loggedNames, id + 1);
+    return true;
+}
+
+bool StateStore::openLog(const char *mode)
+{
+    if (log)
+        std::fclose(log);
+    log = std::fopen(logPath.c_str(), mode);
+    if (!log)
+        error = "cannot open log '" + logPath + "'";
+    return log != nullptr;
+}
+
+// 4. Append one assignment (Names interned since the last record are logged first, so the slot can be resolved on replay)
+bool StateStore::append(size_t slot, long long value)
+{
+    if (!log && !openLog("ab"))
+        return false;
+
+    for (; symbols && loggedNames < symbols->size() && loggedNames <= slot; ++loggedNames)
+    {
+        const std::string &name = symbols->name(loggedNames);
+        LogRecord r = {NAME_RECORD | loggedNames, 0, (int64_t)name.size()};
+        r.check = recordCheck(r, name.data());
+        const char zero[8] = {};
+        std::fwrite(&r, sizeof(r), 1, log);
+        std::fwrite(name.data(), 1, name.size(), log);
+        std::fwrite(zero, 1, padded(name.size()) - name.size(), log);
+    }
+
+    LogRecord r = {(uint32_t)slot, 0, (int64_t)value};
+    r.check = recordCheck(r, nullptr);
+    ++records;
+    ++total;
+    return std::fwrite(&r, sizeof(r), 1, log) == 1;
+}
+
+// 4.1 Flush log (fsync where available : record survive a power loss, not only a crash)
+bool StateStore::flush()
+{
+    if (!log)
+        return true;
+    if (std::fflush(log) != 0)
+        return false;
+#ifndef _WIN32
+    ::fsync(::fileno(log));
+#endif
+    return true;
+}
+
+// 5. Snapshot : write <base>.snap.tmp, rename it over the old one, then empty the log
+bool StateStore::snapshot(const Evaluator &env)
+{
+    TraceSpan span("stateSnapshot");
+    error.clear();
+    flush();
+
+    // A. Payload (values, name lengths, name bytes) + header with its checksum
+    const std::vector<long long> &vars = env.variables();
+    const size_t names = symbols && symbols->size() > SymbolTable::SINGLE_LETTERS ? symbols->size() - SymbolTable::SINGLE_LETTERS : 0;
+    std::string payload;
+    payload.append((const char *)vars.data(), vars.size() * sizeof(long long));
+    for (size_t i = 0; i < names; ++i)
+    {
+        const uint32_t length = (uint32_t)symbols->name((uint32_t)(SymbolTable::SINGLE_LETTERS + i)).size();
+        payload.append((const char *)&length, 4);
+    }
+    size_t nameBytes = 0;
+    for (size_t i = 0; i < names; ++i)
+    {
+        const std::string &name = symbols->name((uint32_t)(SymbolTable::SINGLE_LETTERS + i));
+        payload += name;
+        nameBytes += name.size();
+    }
+
+    SnapshotHeader h = {};
+    std::memcpy(h.magic, SNAPSHOT_MAGIC, sizeof(h.magic));
+    h.version = SNAPSHOT_VERSION;
+    h.headerSize = sizeof(h);
+    h.variables = vars.size();
+    h.names = names;
+    h.nameBytes = nameBytes;
+    h.assignments = total;
+    h.checksum = PerfectHash::hash(payload.data(), payload.size(), 0);
+
+    // B. Write + sync temporary file
+    const std::string tmpPath = snapPath + ".tmp";
+    std::FILE *file = std::fopen(tmpPath.c_str(), "wb");
+    if (!file)
+    {
+        error = "cannot write '" + tmpPath + "'";
+        return false;
+    }
+    bool ok = std::fwrite(&h, sizeof(h), 1, file) == 1 && std::fwrite(payload.data(), 1, payload.size(), file) == payload.size();
+    ok = std::fflush(file) == 0 && ok;
+#ifndef _WIN32
+    ok = ::fsync(::fileno(file)) == 0 && ok;
+#endif
+    std::fclose(file);
+
+    // C. Replace old snapshot (Crash before this point : old snapshot + full log still valid)
+    std::error_code ec;
+    if (ok)
+        std::filesystem::rename(tmpPath, snapPath, ec);
+    if (!ok || ec)
+    {
+        error = "cannot replace snapshot '" + snapPath + "'";
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    // D. Log restart empty (Crash before this point : log replayed over the new snapshot, same result)
+    records = 0;
+    loggedNames = (uint32_t)(SymbolTable::SINGLE_LETTERS + names);
+    return openLog("wb");
+}
@@ -0,0 +1,167 @@
+#include "../include/symbol_table.hpp"     // Reference to Class header
+#include <algorithm>
+#include <cstring>
+
+// 1. Seeded string hash (FNV-1a + final mix so different seeds give unrelated values)
+uint64_t PerfectHash::hash(const char *text, size_t length, uint64_t seed)
+{
+    uint64_t h = 1469598103934665603ULL ^ (seed * 0x9E3779B97F4A7C15ULL);
+    for (size_t i = 0; i < length; ++i)
+    {
+        h ^= (unsigned char)text[i];
+        h *= 1099511628211ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// 2. Build : group names by bucket, place biggest bucket first, try seed 1, 2, ... until all its names land on free index
+bool PerfectHash::build(const std::vector<std::string> &keys)
+{
+    const size_t MAX_SEED = 1u << 20;
+    count = keys.size();
+    seeds.assign(std::max<size_t>(1, count), 0);
+    if (count == 0)
+        return true;
+
+    std::vector<std::vector<size_t>> buckets(seeds.size());
+    for (size_t k = 0; k < count; ++k)
+        buckets[hash(keys[k].data(), keys[k].size(), 0) % seeds.size()].push_back(k);
+
+    std::vector<size_t> order(buckets.size());
+    for (size_t b = 0; b < order.size(); ++b)
+        order[b] = b;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+    std::vector<bool> used(count, false);
+    std::vector<size_t> placed;
+    for (size_t b : order)
+    {
+        if (buckets[b].empty())
+            break;
+
+        bool done = false;
+        for (uint32_t seed = 1; seed < MAX_SEED && !done; ++seed)
+        {
+            placed.clear();
+            done = true;
+            for (size_t k : buckets[b])
+            {
+                const size_t at = hash(keys[k].data(), keys[k].size(), seed) % count;
+                if (used[at] || std::find(placed.begin(), placed.end(), at) != placed.end())
+                {
+                    done = false;
+                    break;
+                }
+                placed.push_back(at);
+            }
+            if (done)
+            {
+                seeds[b] = seed;
+                for (size_t at : placed)
+                    used[at] = true;
+            }
+        }
+        if (!done)
+        {
+            count = 0;  // Duplicate names (or unlucky set) : no perfect hash
+            return false;
+        }
+    }
+    return true;
+}
+
+// 2.1 Lookup
+size_t PerfectHash::indexOf(const char *text, size_t length) const
+{
+    const uint32_t seed = seeds[hash(text, length, 0) % seeds.size()];
+    return hash(text, length, seed) % count;
+}
+
+// 3. Constructor : 'a' ... 'z' take id 0 ... 25
+SymbolTable::SymbolTable() : slots(64, NO_SYMBOL)
+{
+    for (char c = 'a'; c <= 'z'; ++c)
+        intern(&c, 1);
+}
+
+bool SymbolTable::matches(uint32_t id, const char *text, size_t length) const
+{
+    const std::string &n = names[id];
+    return n.size() == length && std::memcmp(n.data(), text, length) == 0;
+}
+
+// 3.1 Put id into open addressing table
+void SymbolTable::insertSlot(uint32_t id)
+{
+    const size_t mask = slots.size() - 1;
+    size_t at = PerfectHash::hash(names[id].data(), names[id].size(), 0) & mask;
+    while (slots[at] != NO_SYMBOL)
+        at = (at + 1) & mask;
+    slots[at] = id;
+}
+
+// 4. Find (Perfect hash first when built : one verify, no probing)
+uint32_t SymbolTable::find(const char *text, size_t length) const
+{
+    if (perfect.size())
+    {
+        const uint32_t id = perfectIds[perfect.indexOf(text, length)];
+        if (matches(id, text, length))
+            return id;
+    }
+
+    const size_t mask = slots.size() - 1;
+    for (size_t at = PerfectHash::hash(text, length, 0) & mask; slots[at] != NO_SYMBOL; at = (at + 1) & mask)
+    {
+        if (matches(slots[at], text, length))
+            return slots[at];
+    }
+    return NO_SYMBOL;
+}
+
+// 4.1 Intern
+uint32_t SymbolTable::intern(const char *text, size_t length)
+{
+    uint32_t id = find(text, length);
+    if (id != NO_SYMBOL)
+        return id;
+
+    id = (uint32_t)names.size();
+    names.emplace_back(text, length);
+    if (names.size() * 2 > slots.size()) // Keep load under 50% : double and re-insert
+    {
+        slots.assign(slots.size() * 2, NO_SYMBOL);
+        for (uint32_t i = 0; i < names.size(); ++i)
+            insertSlot(i);
+    }
+    else
+        insertSlot(id);
+    return id;
+}
+
+// 5. Known variable set : intern them (dense id), then build perfect hash over every name
+bool SymbolTable::usePerfectHash(const std::vector<std::string> &known)
+{
+    for (const auto &name : known)
+        intern(name);
+    if (names.size() == perfectNames)
+        return hasPerfectHash(); // Same set as the last build
+    perfectNames = names.size();
+
+    perfectIds.clear();
+    if (names.size() > PERFECT_HASH_LIMIT)
+    {
+        perfect.build({}); // Drop an older one : lookups probe
+        return false;
+    }
+    if (!perfect.build(names))
+        return false;
+
+    perfectIds.assign(names.size(), 0);
+    for (uint32_t id = 0; id < names.size(); ++id)
+        perfectIds[perfect.indexOf(names[id].data(), names[id].size())] = id;
+    return true;
+}
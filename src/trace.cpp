@@ -0,0 +1,148 @@
+#include "../include/trace.hpp"     // Reference to Class header
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+
+// 1. Trace state
+namespace
+{
+    const size_t RING_SIZE = 1 << 14;       // Events per thread (Power of 2)
+    const size_t MAX_THREADS = 64;
+
+    // One complete event ("ph":"X")
+    struct Event
+    {
+        const char *name;
+        uint64_t start;         // ns since trace clock start
+        uint64_t duration;      // ns
+        uint64_t statement;     // Statement number of the thread (args.stmt)
+    };
+
+    // Ring buffer of one thread (Single writer, head published with release)
+    struct ThreadBuffer
+    {
+        Event events[RING_SIZE];
+        std::atomic<uint64_t> head{0};      // Total event written
+        unsigned tid = 0;
+    };
+
+    std::atomic<bool> enabled(false);
+    std::atomic<unsigned> sampleEvery(1);
+    std::atomic<ThreadBuffer *> buffers[MAX_THREADS];
+    std::atomic<unsigned> bufferCount(0);
+    const std::chrono::steady_clock::time_point clockStart = std::chrono::steady_clock::now();
+
+    thread_local ThreadBuffer *localBuffer = nullptr;
+    thread_local bool localSampled = false;
+    thread_local uint64_t localStatement = 0;
+
+    uint64_t nowNs()
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - clockStart).count();
+    }
+
+    // 1.1 Buffer of calling thread (Created + registered on first use, kept after thread exit for dump)
+    ThreadBuffer *threadBuffer()
+    {
+        if (!localBuffer)
+        {
+            const unsigned slot = bufferCount.fetch_add(1);
+            if (slot >= MAX_THREADS)
+                return nullptr; // Too many threads : this one is not traced
+            localBuffer = new ThreadBuffer();
+            localBuffer->tid = slot + 1;
+            buffers[slot].store(localBuffer, std::memory_order_release);
+        }
+        return localBuffer;
+    }
+}
+
+// 2. Switch
+void Trace::enable(unsigned every)
+{
+    sampleEvery.store(every ? every : 1, std::memory_order_relaxed);
+    enabled.store(true, std::memory_order_release);
+}
+
+void Trace::disable() { enabled.store(false, std::memory_order_release); }
+
+bool Trace::isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+// 2.1 Sampling : one statement out of sampleEvery (per thread)
+void Trace::beginStatement()
+{
+    ++localStatement;
+    localSampled = enabled.load(std::memory_order_relaxed) && (localStatement % sampleEvery.load(std::memory_order_relaxed)) == 0;
+}
+
+bool Trace::sampled() { return localSampled; }
+
+// 2.2 Hand the decision to worker threads (Their spans carry the statement number of the caller)
+TraceTask Trace::task()
+{
+    TraceTask current;
+    current.sampled = localSampled;
+    current.statement = localStatement;
+    return current;
+}
+
+void Trace::adopt(const TraceTask &task)
+{
+    localSampled = task.sampled && enabled.load(std::memory_order_relaxed);
+    localStatement = task.statement;
+}
+
+// 3. Span (Only timestamp when sampled)
+TraceSpan::TraceSpan(const char *spanName) : name(nullptr), start(0)
+{
+    if (!localSampled)
+        return;
+    name = spanName;
+    start = nowNs();
+}
+
+TraceSpan::~TraceSpan()
+{
+    if (!name)
+        return;
+    const uint64_t end = nowNs();  // Before buffer lookup (first call allocate it)
+    ThreadBuffer *buf = threadBuffer();
+    if (!buf)
+        return;
+
+    const uint64_t h = buf->head.load(std::memory_order_relaxed);
+    buf->events[h & (RING_SIZE - 1)] = Event{name, start, end - start, localStatement};
+    buf->head.store(h + 1, std::memory_order_release);
+}
+
+// 4. Dump as Chrome trace-event JSON
+void Trace::writeChromeJson(std::ostream &out)
+{
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    char line[256];
+
+    const unsigned count = std::min<unsigned>(bufferCount.load(std::memory_order_acquire), MAX_THREADS);
+    for (unsigned t = 0; t < count; ++t)
+    {
+        const ThreadBuffer *buf = buffers[t].load(std::memory_order_acquire);
+        if (!buf)
+            continue;
+
+        // Oldest event still in the ring first
+        const uint64_t head = buf->head.load(std::memory_order_acquire);
+        const uint64_t begin = head > RING_SIZE ? head - RING_SIZE : 0;
+        for (uint64_t i = begin; i < head; ++i)
+        {
+            const Event &e = buf->events[i & (RING_SIZE - 1)];
+            std::snprintf(line, sizeof(line),
+                          "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"stmt\":%llu}}",
+                          first ? "" : ",", e.name, (double)e.start / 1000.0, (double)e.duration / 1000.0, buf->tid,
+                          (unsigned long long)e.statement);
+            out << line;
+            first = false;
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
@@ -0,0 +1,35 @@
+#pragma once                // Header Guard
+#include <iostream>
+#include <string>
+
+// Minimal check helper shared by the tests (No framework : every test is a plain program, exit code 0 = pass)
+namespace compy_test
+{
+    inline int &failures()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    inline void fail(const char *file, int line, const std::string &what)
+    {
+        if (++failures() <= 20)    // Keep the first few, a broken invariant usually fail everywhere
+            std::cerr << file << ":" << line << ": check failed: " << what << std::endl;
+    }
+
+    // Print verdict, return process exit code
+    inline int finish(const char *name)
+    {
+        if (failures())
+            std::cerr << name << ": FAILED (" << failures() << " checks)" << std::endl;
+        else
+            std::cout << name << ": ok" << std::endl;
+        return failures() ? 1 : 0;
+    }
+}
+
+#define CHECK(cond) \
+    do { if (!(cond)) compy_test::fail(__FILE__, __LINE__, #cond); } while (0)
+
+#define CHECK_EQ(a, b) \
+    do { if (!((a) == (b))) compy_test::fail(__FILE__, __LINE__, std::string(#a " == " #b)); } while (0)
@@ -0,0 +1,68 @@
+#pragma once                // Header Guard
+#include <cstdint>
+#include <random>
+#include <string>
+
+// RandomProgram Class : random valid COMPY statements for differential tests (Same seed = same program)
+// Operands are variables a ... f, small literals and now and then a literal past 64-bit; divisors are often 0
+// at run time (never the literal "0", Parser reject that), so runtime errors are exercised too.
+// safeDivisors : every divisor is "(e) % 7 + 8" (Always 2 ... 14), for workloads that must run to the end.
+class RandomProgram
+{
+
+// Public Member
+public:
+    explicit RandomProgram(uint32_t seed, bool power = true, bool safeDivisors = false) : rng(seed), withPower(power), safe(safeDivisors) {}
+
+    std::string expression(int depth)
+    {
+        const unsigned pick = next(10);
+        if (depth <= 0 || pick < 3)
+            return operand();
+        if (pick == 3)
+            return "-" + expression(depth - 1);
+        if (pick == 4)
+            return "(" + expression(depth - 1) + ")";
+        static const char *ops[] = {"+", "-", "*", "/", "%", "^"};
+        const char *op = ops[next(withPower ? 6 : 5)];
+        std::string right = expression(depth - 1);
+        if (op[0] == '^')
+            right = "(" + right + ") % 5";    // Keep exponents small most of the time
+        else if (safe && (op[0] == '/' || op[0] == '%'))
+            right = "((" + right + ") % 7 + 8)";
+        return expression(depth - 1) + " " + op + " " + right;
+    }
+
+    std::string statement(int depth = 4) { return std::string(1, (char)('a' + next(6))) + " = " + expression(depth) + ";"; }
+
+    // Variables start non-zero (A divisor that is still the initial 0 would be rejected at compile time)
+    std::string program(size_t statements, int depth = 4)
+    {
+        std::string text;
+        for (char name = 'a'; name <= 'f'; ++name)
+            text += std::string(1, name) + " = " + std::to_string(next(9) + 1) + ";\n";
+        for (size_t i = 0; i < statements; ++i)
+            text += statement(depth) + "\n";
+        return text;
+    }
+
+    unsigned next(unsigned bound) { return (unsigned)(rng() % bound); }
+
+// Private Member
+private:
+    std::mt19937 rng;
+    bool withPower;
+    bool safe;
+
+    std::string operand()
+    {
+        const unsigned pick = next(12);
+        if (pick < 6)
+            return std::string(1, (char)('a' + pick));
+        if (pick == 6)
+            return "9223372036854775807";   // INT64_MAX : overflow on the next + or *
+        if (pick == 7)
+            return "123456789012345678901234567890";
+        return std::to_string(next(20) + 1);
+    }
+};
@@ -0,0 +1,65 @@
+#!/bin/sh
+# Build every tests/test_*.cpp against src/ (main.cpp left out) and run it; main is built too for the tests that
+# drive the command line (path given in COMPY_MAIN). "#if COMPY_COMPILE_FAIL == n" blocks of a test must fail to build.
+# A test with a "// Build flags: ..." line is built, library included, with those flags added (e.g. -DCOMPY_ALLOC_TRACE).
+# Exit code = number of failed tests.
+#   tests/run_tests.sh            all tests
+#   tests/run_tests.sh codegen    tests/test_codegen.cpp only
+cd "$(dirname "$0")/.." || exit 1
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:--O2}
+OUT=${OUT:-build/tests}
+FLAGS="-std=c++17 -pthread -Iinclude $CXXFLAGS"
+mkdir -p "$OUT/obj" && OUT=$(cd "$OUT" && pwd) || exit 1     # Absolute from here on (OUT may be given relative or absolute)
+
+# A. Library objects (Rebuilt when the source or any header is newer) : library <object dir> <extra flags>, LIB = objects
+library() {
+    mkdir -p "$1" || exit 1
+    LIB=""
+    for src in src/*.cpp; do
+        obj="$1/$(basename "$src" .cpp).o"
+        if [ ! -f "$obj" ] || [ -n "$(find "$src" include -newer "$obj" 2>/dev/null | head -n 1)" ]; then
+            $CXX $FLAGS $2 -c "$src" -o "$obj" || exit 1
+        fi
+        [ "$src" = "src/main.cpp" ] || LIB="$LIB $obj"
+    done
+}
+library "$OUT/obj" ""
+OBJS=$LIB
+$CXX $FLAGS "$OUT/obj/main.o" $OBJS -o "$OUT/main" -ldl || exit 1
+COMPY_MAIN="$OUT/main"
+export COMPY_MAIN
+
+# B. Tests
+failed=0
+for test in tests/test_*.cpp; do
+    name=$(basename "$test" .cpp)
+    if [ $# -gt 0 ] && [ "test_$1" != "$name" ]; then
+        continue
+    fi
+    extra=$(sed -n 's|^// Build flags: ||p' "$test" | head -n 1)
+    objs=$OBJS
+    if [ -n "$extra" ]; then
+        library "$OUT/obj-$name" "$extra"
+        objs=$LIB
+    fi
+    if ! $CXX $FLAGS $extra "$test" $objs -o "$OUT/$name" -ldl; then
+        echo "$name: BUILD FAILED"
+        failed=$((failed + 1))
+        continue
+    fi
+    "$OUT/$name" || failed=$((failed + 1))
+
+    # B.1 Code that must not compile (#if COMPY_COMPILE_FAIL == n // expected message) : built alone, must fail with that message
+    grep '^#if COMPY_COMPILE_FAIL == ' "$test" | while read -r _ _ _ n _ message; do
+        if $CXX $FLAGS -fsyntax-only -DCOMPY_COMPILE_FAIL="$n" "$test" > "$OUT/$name.fail$n.log" 2>&1; then
+            echo "$name: compile-fail case $n compiled"
+            exit 1
+        fi
+        if ! grep -qF "$message" "$OUT/$name.fail$n.log"; then
+            echo "$name: compile-fail case $n failed without '$message' (see $OUT/$name.fail$n.log)"
+            exit 1
+        fi
+    done || failed=$((failed + 1))
+done
+exit $failed
@@ -0,0 +1,105 @@
+// AllocTrace (Traced build) : per-statement counter, phase charges, over-aligned new / delete counted and aligned,
+// report sites named after the COMPY / test function that allocated rather than libstdc++ internals
+// Build flags: -DCOMPY_ALLOC_TRACE -rdynamic
+#include "check.hpp"
+#include "../include/alloc_trace.hpp"
+#include "../include/lexer.hpp"
+#include <sstream>
+#include <vector>
+
+struct alignas(64) Line
+{
+    char bytes[64];
+};
+
+// Allocate through std::vector growth (Site must be this function, not _M_realloc_insert / operator new)
+__attribute__((noinline)) size_t fillFromTest(size_t count)
+{
+    std::vector<long> values;
+    for (size_t i = 0; i < count; ++i)
+        values.push_back((long)i);
+    return values.size();
+}
+
+// Out of line so new / delete pairs are not elided
+__attribute__((noinline)) void newAndDelete(int value)
+{
+    int *volatile p = new int(value);
+    delete p;
+}
+
+static std::string report()
+{
+    std::ostringstream out;
+    std::streambuf *old = std::cout.rdbuf(out.rdbuf());
+    AllocTrace::report(5);
+    std::cout.rdbuf(old);
+    return out.str();
+}
+
+int main()
+{
+    CHECK(AllocTrace::enabled);
+
+    // A. Counter : reset by beginStatement, one per new
+    AllocTrace::beginStatement();
+    CHECK_EQ(AllocTrace::allocations(), (size_t)0);
+    std::vector<int *> blocks;
+    blocks.reserve(100);
+    AllocTrace::beginStatement();
+    for (int i = 0; i < 100; ++i)
+        blocks.push_back(new int(i));
+    CHECK_EQ(AllocTrace::allocations(), (size_t)100);
+    for (int *p : blocks)
+        delete p;
+    CHECK_EQ(AllocTrace::allocations(), (size_t)100);                  // Frees do not lower the count
+
+    // B. Over-aligned new / new[] : counted, aligned, freed through the aligned delete
+    AllocTrace::beginStatement();
+    Line *one = new Line();
+    Line *many = new Line[7];
+    CHECK_EQ((size_t)one % alignof(Line), (size_t)0);
+    CHECK_EQ((size_t)many % alignof(Line), (size_t)0);
+    CHECK_EQ(AllocTrace::allocations(), (size_t)2);
+    many[6].bytes[63] = 1;
+    delete one;
+    delete[] many;
+    {
+        std::vector<Line> lines(3);
+        CHECK_EQ((size_t)lines.data() % alignof(Line), (size_t)0);
+    }
+    CHECK_EQ(AllocTrace::allocations(), (size_t)3);
+
+    // C. Phases : allocation inside an AllocPhase charged to it, nested phase restored on exit
+    AllocTrace::beginStatement();
+    {
+        AllocPhase outer("outerphase");
+        newAndDelete(1);
+        {
+            AllocPhase inner("innerphase");
+            newAndDelete(2);
+        }
+        newAndDelete(3);
+    }
+    const std::string phases = report();
+    CHECK(phases.find("outerphase  2 ") != std::string::npos);
+    CHECK(phases.find("innerphase  1 ") != std::string::npos);
+
+    // D. Sites : the function above the std::vector machinery, and Lexer code for a tokenize
+    AllocTrace::beginStatement();
+    CHECK_EQ(fillFromTest(5000), (size_t)5000);
+    const std::string sites = report();
+    CHECK(sites.find("fillFromTest") != std::string::npos);
+    CHECK(sites.find("::_M_") == std::string::npos);
+
+    AllocTrace::beginStatement();
+    {
+        Lexer lexer("x = 1 + 2 * (y - 3);\nz = x / 7;");
+        lexer.tokenize();
+    }
+    CHECK(AllocTrace::allocations() > 0);
+    const std::string lexing = report();
+    CHECK(lexing.find("Lexer::") != std::string::npos);
+    CHECK(lexing.find("::_M_") == std::string::npos);
+    return compy_test::finish("test_alloc_trace");
+}
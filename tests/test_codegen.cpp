@@ -0,0 +1,111 @@
+// CodeGen / NativeProgram end to end : generated code built with g++ must give the same variables and
+// the same runtime error as the interpreter, on random programs and through main --native vs --run
+#include "check.hpp"
+#include "random_program.hpp"
+#include "../include/codegen.hpp"
+#include "../include/lexer.hpp"
+#include "../include/program.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+// Output of a command, lines starting with a timing prefix removed (They differ from run to run)
+static std::string capture(const std::string &command)
+{
+    std::string out, line;
+    FILE *pipe = popen(command.c_str(), "r");
+    if (!pipe)
+        return "<popen failed>";
+    char buffer[4096];
+    while (fgets(buffer, sizeof(buffer), pipe))
+    {
+        line = buffer;
+        if (line.rfind("Statements:", 0) != 0 && line.rfind("Workers:", 0) != 0 && line.rfind("Native:", 0) != 0 &&
+            line.rfind("Runtime checks", 0) != 0 && line.rfind("Parallel run", 0) != 0)
+            out += line;
+    }
+    pclose(pipe);
+    return out;
+}
+
+int main()
+{
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "compy-test-codegen";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    // A. Random programs (+ one whose divisor wrap around to 0 : overflow hide it from RangeAnalysis) : interpreter vs generated code
+    std::vector<std::string> sources{"a = 9223372036854775807 + 9223372036854775807 + 2;\nb = 7;\nc = b / a;\nd = 1;\n"};
+    for (uint32_t seed = 1; seed <= 80; ++seed)
+        sources.push_back(RandomProgram(seed).program(25));
+
+    size_t compared = 0, failures = 0;
+    for (size_t k = 0; k < sources.size(); ++k)
+    {
+        Program program(sources[k]);
+        if (!program.compile())
+            continue; // Divisor proven always 0 : rejected before any backend
+
+        Evaluator env;
+        const bool ok = env.run(program.statements());
+
+        CodeGen codegen(program.statements());
+        NativeProgram native;
+        const bool built = native.build(codegen.emit(), (dir / ("p" + std::to_string(k))).string());
+        CHECK(built);
+        if (!built)
+        {
+            std::cerr << native.getError() << std::endl;
+            continue;
+        }
+        std::vector<long long> vars(codegen.slotCount(), 0);
+        const int failed = native.run(vars.data());
+        CHECK_EQ(failed == 0, ok);
+        if (k == 0)
+            CHECK_EQ(failed, 3); // Statement number of the division
+        for (size_t slot = 0; slot < vars.size(); ++slot)
+            CHECK_EQ(vars[slot], env.get(slot));
+        ++compared;
+        failures += failed != 0;
+    }
+    CHECK(compared >= 25);
+    CHECK(failures > 0);
+
+    // B. Deep chain : emitted without recursion (No build, the point is the generator itself)
+    {
+        std::string text = "x = a";
+        for (int i = 1; i < 200000; ++i)
+            text += i % 2 ? " + a" : " - 1";
+        text += ";";
+        Lexer lexer(text);
+        std::vector<Token> tokens = lexer.tokenize();
+        Parser parser(tokens);
+        CHECK(parser.parse());
+        std::vector<const Parser::Node *> stmts{parser.getRoot()};
+        CodeGen codegen(stmts);
+        const std::string code = codegen.emit();
+        CHECK(code.find("long long t199998 = ") != std::string::npos);
+        CHECK(code.find("v[23] = t199998;") != std::string::npos);
+    }
+
+    // C. Command line : main --native print the same variables and error as main --run
+    const char *mainPath = std::getenv("COMPY_MAIN");
+    if (mainPath)
+    {
+        for (size_t k = 0; k < 6; ++k)
+        {
+            const std::string file = (dir / ("cli" + std::to_string(k) + ".txt")).string();
+            std::ofstream(file) << sources[k];
+            const std::string run = capture(std::string(mainPath) + " --run < " + file + " 2>&1");
+            const std::string native = capture(std::string(mainPath) + " --native < " + file + " 2>&1");
+            CHECK_EQ(run, native);
+        }
+    }
+    else
+        std::cout << "test_codegen: COMPY_MAIN not set, command line part skipped" << std::endl;
+
+    std::filesystem::remove_all(dir);
+    return compy_test::finish("test_codegen");
+}
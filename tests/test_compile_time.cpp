@@ -0,0 +1,121 @@
+// compy_ct::compile : formulas parsed and evaluated by the compiler must agree with Lexer + Parser + Evaluator
+// A. static_assert on fixed formulas (Checked while this file compiles)
+// B. Same formulas + random statements at run time, against the interpreter (Result, accept / reject)
+// C. Formulas that must not compile : each #if COMPY_COMPILE_FAIL block is built alone by run_tests.sh,
+//    which expect the build to fail with the message written after "//" on the #if line
+#include "check.hpp"
+#include "random_program.hpp"
+#include "../include/compile_time.hpp"
+#include "../include/lexer.hpp"
+#include <algorithm>
+
+// Value of the assigned variable after running formula on a = 7, b = -3, c = 2 (Everything else 0)
+template <size_t N>
+constexpr long long eval(const compy_ct::Formula<N> &f)
+{
+    long long vars[26] = {7, -3, 2};
+    if (!f(vars))
+        return -999999;                 // Division by zero at run time
+    return vars[f.target];
+}
+
+constexpr auto F1 = compy_ct::compile("x = (a + 2) * b;");
+constexpr auto F2 = compy_ct::compile("x = a - b - c;");
+constexpr auto F3 = compy_ct::compile("x = c ^ c ^ 3;");
+constexpr auto F4 = compy_ct::compile("x = -c ^ 2 + a % b;");
+constexpr auto F5 = compy_ct::compile("x = a / b * b + a % b;");
+constexpr auto F6 = compy_ct::compile("x = 9223372036854775807 + a;");
+constexpr auto F7 = compy_ct::compile("x = a / (c - 2);");
+constexpr auto F8 = compy_ct::compile("y = --a - -(b);");
+static_assert(eval(F1) == -27, "precedence of '*' over '+'");
+static_assert(eval(F2) == 8, "'-' is left associative");
+static_assert(eval(F3) == 256, "'^' is right associative");
+static_assert(eval(F4) == -3, "unary '-' bind looser than '^', '%' sign follow the dividend");
+static_assert(eval(F5) == 7, "(a / b) * b + a % b == a");
+static_assert(eval(F6) == -9223372036854775807LL - 1 + 6, "64-bit wrap around");
+static_assert(eval(F7) == -999999, "division by zero at run time");
+static_assert(eval(F8) == 4 && F8.target == 24, "nested unary minus");
+
+#if COMPY_COMPILE_FAIL == 1 // division by zero is not allowed
+constexpr auto BAD = compy_ct::compile("x = a / 0;");
+#endif
+#if COMPY_COMPILE_FAIL == 2 // missing closing parenthesis
+constexpr auto BAD = compy_ct::compile("x = (a + 1;");
+#endif
+#if COMPY_COMPILE_FAIL == 3 // identifier is a single lowercase letter
+constexpr auto BAD = compy_ct::compile("x = Ab + 1;");
+#endif
+#if COMPY_COMPILE_FAIL == 4 // missing operator before operand
+constexpr auto BAD = compy_ct::compile("x = a b;");
+#endif
+
+// Interpreter : false when Lexer / Parser reject the statement, value = -999999 on runtime error
+static bool interpret(const std::string &text, long long &value)
+{
+    Lexer lexer(text);
+    const std::vector<Token> tokens = lexer.tokenize();
+    Parser parser(tokens);
+    if (!parser.parse() || lexer.hasLexicalErrors())
+        return false;
+    Evaluator env;
+    env.set(0, 7);
+    env.set(1, -3);
+    env.set(2, 2);
+    value = env.execute(parser.getRoot()) ? env.get(variableSlot(parser.getRoot()->left)) : -999999;
+    return true;
+}
+
+// Same statement through compy_ct at run time (Padded with spaces to the fixed literal size; errors are thrown)
+static bool compileAtRunTime(const std::string &text, long long &value)
+{
+    char buffer[512];
+    if (text.size() >= sizeof(buffer))
+        return false;
+    std::fill(buffer, buffer + sizeof(buffer) - 1, ' ');
+    std::copy(text.begin(), text.end(), buffer);
+    buffer[sizeof(buffer) - 1] = '\0';
+    try
+    {
+        value = eval(compy_ct::compile(buffer));
+        return true;
+    }
+    catch (const char *)
+    {
+        return false;
+    }
+}
+
+int main()
+{
+    // B. Fixed formulas : value computed by the compiler == value computed by the interpreter
+    const std::pair<const char *, long long> fixed[] = {
+        {"x = (a + 2) * b;", eval(F1)}, {"x = a - b - c;", eval(F2)}, {"x = c ^ c ^ 3;", eval(F3)},
+        {"x = -c ^ 2 + a % b;", eval(F4)}, {"x = a / b * b + a % b;", eval(F5)}, {"x = 9223372036854775807 + a;", eval(F6)},
+        {"x = a / (c - 2);", eval(F7)}, {"y = --a - -(b);", eval(F8)}};
+    for (const auto &f : fixed)
+    {
+        long long value = 0;
+        CHECK(interpret(f.first, value));
+        CHECK_EQ(value, f.second);
+    }
+
+    // B.1 Random statements, and the same with one character dropped (Often invalid) : same verdict, same value
+    size_t valid = 0;
+    for (uint32_t seed = 1; seed <= 3000; ++seed)
+    {
+        RandomProgram random(seed);
+        std::string text = random.statement(4);
+        if (seed % 2 == 0)
+            text.erase(random.next((unsigned)text.size()), 1);
+        long long expected = 0, actual = 0;
+        const bool accepted = interpret(text, expected);
+        CHECK_EQ(compileAtRunTime(text, actual), accepted);
+        if (accepted)
+        {
+            CHECK_EQ(actual, expected);
+            ++valid;
+        }
+    }
+    CHECK(valid > 1000);
+    return compy_test::finish("test_compile_time");
+}
@@ -0,0 +1,87 @@
+// TreeExporter : exact small outputs, output stay valid UTF-8 whatever bytes a lexeme hold, deep tree without recursion
+#include "check.hpp"
+#include "../include/exporter.hpp"
+#include "../include/lexer.hpp"
+#include <random>
+#include <sstream>
+
+static bool validUtf8(const std::string &s)
+{
+    for (size_t i = utf8::skipAscii(s.data(), s.size(), 0); i < s.size(); i = utf8::skipAscii(s.data(), s.size(), i))
+    {
+        bool valid = false;
+        i += utf8::decode(s.data(), s.size(), i, valid);
+        if (!valid)
+            return false;
+    }
+    return true;
+}
+
+int main()
+{
+    // A. Exact output of one small statement
+    {
+        Lexer lexer("x = -a ^ 2 + 3;");
+        const std::vector<Token> tokens = lexer.tokenize();
+        Parser parser(tokens);
+        CHECK(parser.parse());
+        std::ostringstream sexpr, dot;
+        {
+            TreeExporter exporter(sexpr);
+            exporter.writeSExpr(parser.getRoot());
+        }
+        CHECK_EQ(sexpr.str(), std::string("(= x (+ (- (^ a 2)) 3))\n"));
+        {
+            TreeExporter exporter(dot);
+            exporter.writeDot(parser.getRoot());
+        }
+        CHECK(dot.str().find("  n0 -> n1;\n") != std::string::npos);
+    }
+
+    // B. Lexeme with random bytes (INVALID Token keep raw input) : quoted output is always valid UTF-8,
+    //    well-formed characters kept, each malformed byte replaced, quote / backslash / control escaped
+    std::mt19937 rng(7);
+    for (int round = 0; round < 2000; ++round)
+    {
+        std::string raw;
+        const size_t len = rng() % 12;
+        for (size_t i = 0; i < len; ++i)
+            raw += (char)(rng() % 256);
+        std::vector<Token> tokens{Token(TokenType::INVALID, raw, 0)};
+        std::ostringstream out;
+        {
+            TreeExporter exporter(out);
+            exporter.writeJson(tokens, nullptr);
+        }
+        CHECK(validUtf8(out.str()));
+        CHECK(out.str().find('\n') == out.str().size() - 1);    // Newline only at the end : one object per line
+    }
+    {
+        std::vector<Token> tokens{Token(TokenType::INVALID, std::string("\xFF\xC3\xA9\"\\\x01", 6), 0)};
+        std::ostringstream out;
+        {
+            TreeExporter exporter(out);
+            exporter.writeJson(tokens, nullptr);
+        }
+        CHECK(out.str().find("\"value\":\"\xEF\xBF\xBD\xC3\xA9\\\"\\\\\\u0001\"") != std::string::npos);
+    }
+
+    // C. One million Node chain : exported without recursion, every Node once
+    {
+        std::string text = "x = a";
+        for (int i = 0; i < 500000; ++i)
+            text += " + a";
+        text += ";";
+        Lexer lexer(text);
+        const std::vector<Token> tokens = lexer.tokenize();
+        Parser parser(tokens);
+        CHECK(parser.parse());
+        std::ostringstream out;
+        {
+            TreeExporter exporter(out);
+            exporter.writeDot(parser.getRoot());
+        }
+        CHECK(out.str().find("n1000002 [label=\"a\"]") != std::string::npos);
+    }
+    return compy_test::finish("test_exporter");
+}
@@ -0,0 +1,163 @@
+// Integer / BigInt : every int64 operation against __int128, known big values, demotion back to int64, error cases,
+// and ExactEvaluator against Evaluator modulo 2^64 on programs of + - * (Wrap around is exact arithmetic mod 2^64)
+#include "check.hpp"
+#include "../include/exact_evaluator.hpp"
+#include "../include/program.hpp"
+#include <climits>
+#include <random>
+
+static std::string text(__int128 value)
+{
+    const bool negative = value < 0;
+    unsigned __int128 magnitude = negative ? (unsigned __int128)0 - (unsigned __int128)value : (unsigned __int128)value;
+    std::string digits;
+    do
+    {
+        digits.insert(digits.begin(), (char)('0' + (int)(magnitude % 10)));
+        magnitude /= 10;
+    } while (magnitude);
+    return negative ? "-" + digits : digits;
+}
+
+// Decimal text reduced modulo 2^64 (Value Evaluator hold after wrap around)
+static long long wrapped(const std::string &digits)
+{
+    unsigned long long r = 0;
+    for (char c : digits)
+        if (c != '-')
+            r = r * 10 + (unsigned long long)(c - '0');
+    return (long long)(digits[0] == '-' ? 0 - r : r);
+}
+
+static Integer literal(const std::string &digits)
+{
+    Integer out;
+    CHECK(Integer::fromLiteral(digits, out) == ArithError::NONE);
+    return out;
+}
+
+// Expression of + - * and unary minus only (Ring operations : exact result mod 2^64 = wrapped result)
+static std::string ringExpression(std::mt19937 &rng, int depth)
+{
+    const unsigned pick = rng() % 10;
+    if (depth <= 0 || pick < 3)
+    {
+        static const char *operands[] = {"a", "b", "c", "d", "e", "f", "7", "9223372036854775807", "123456789012345678901234567890"};
+        return operands[rng() % 9];
+    }
+    if (pick == 3)
+        return "-" + ringExpression(rng, depth - 1);
+    if (pick == 4)
+        return "(" + ringExpression(rng, depth - 1) + ")";
+    static const char *ops[] = {" + ", " - ", " * "};
+    return ringExpression(rng, depth - 1) + ops[rng() % 3] + ringExpression(rng, depth - 1);
+}
+
+int main()
+{
+    // A. Single operations on int64 operands (Edges + random) : same value as 128-bit arithmetic, small again when it fit
+    std::vector<long long> values = {0, 1, -1, 2, -2, 3, 1000000007, LLONG_MAX, LLONG_MAX - 1, LLONG_MIN, LLONG_MIN + 1,
+                                     (long long)1 << 32, -((long long)1 << 32), (long long)3037000499LL, (long long)3037000500LL};
+    std::mt19937_64 rng(41);
+    for (int i = 0; i < 60; ++i)
+        values.push_back((long long)(rng() >> (rng() % 64)) * ((rng() & 1) ? -1 : 1));
+    for (long long x : values)
+    {
+        for (long long y : values)
+        {
+            const Integer a(x), b(y);
+            Integer out;
+            const __int128 wide[] = {(__int128)x + y, (__int128)x - y, (__int128)x * y};
+            ArithError (*ops[])(const Integer &, const Integer &, Integer &) = {Integer::add, Integer::sub, Integer::mul};
+            for (int k = 0; k < 3; ++k)
+            {
+                CHECK(ops[k](a, b, out) == ArithError::NONE);
+                CHECK_EQ(out.toString(), text(wide[k]));
+                CHECK_EQ(out.isSmall(), wide[k] >= LLONG_MIN && wide[k] <= LLONG_MAX);
+            }
+            if (y == 0)
+            {
+                CHECK(Integer::div(a, b, out) == ArithError::DIVISION_BY_ZERO);
+                CHECK(Integer::mod(a, b, out) == ArithError::DIVISION_BY_ZERO);
+                continue;
+            }
+            CHECK(Integer::div(a, b, out) == ArithError::NONE);
+            CHECK_EQ(out.toString(), text((__int128)x / y));
+            CHECK(Integer::mod(a, b, out) == ArithError::NONE);
+            CHECK_EQ(out.toString(), text((__int128)x % y));
+        }
+    }
+
+    // B. Known big values, and results that come back to int64
+    {
+        Integer f(1), out;
+        for (int i = 2; i <= 40; ++i)
+            CHECK(Integer::mul(f, Integer(i), f) == ArithError::NONE);
+        CHECK_EQ(f.toString(), std::string("815915283247897734345611269596115894272000000000"));
+        CHECK(Integer::pow(Integer(2), Integer(200), out) == ArithError::NONE);
+        CHECK_EQ(out.toString(), std::string("1606938044258990275541962092341162602522202993782792835301376"));
+        CHECK(Integer::pow(Integer(-3), Integer(41), out) == ArithError::NONE);
+        CHECK_EQ(out.toString(), std::string("-36472996377170786403"));
+        CHECK(Integer::pow(Integer(5), Integer(-2), out) == ArithError::NONE && out.isZero());
+        CHECK(Integer::pow(Integer(0), Integer(-1), out) == ArithError::DIVISION_BY_ZERO);
+
+        const Integer big = literal("123456789012345678901234567890");
+        CHECK(!big.isSmall());
+        CHECK(Integer::div(f, big, out) == ArithError::NONE);
+        CHECK_EQ(out.toString(), std::string("6608913853788196338"));
+        CHECK(out.isSmall());
+        CHECK(Integer::mod(f, big, out) == ArithError::NONE);
+        CHECK_EQ(out.toString(), std::string("29782814165348964012089613180"));
+        CHECK(Integer::sub(big, big, out) == ArithError::NONE && out.isSmall() && out.isZero());
+        CHECK(Integer::mul(big, Integer(-1), out) == ArithError::NONE);
+        CHECK_EQ(out.toString(), std::string("-123456789012345678901234567890"));
+        CHECK(Integer::div(Integer(LLONG_MIN), Integer(-1), out) == ArithError::NONE);
+        CHECK_EQ(out.toString(), std::string("9223372036854775808"));
+        CHECK(Integer::negate(Integer(LLONG_MIN), out) == ArithError::NONE && !out.isSmall());
+        CHECK(Integer::negate(out, out) == ArithError::NONE && out.isSmall() && out.toInt64() == LLONG_MIN);
+        CHECK(Integer::div(big, Integer(0), out) == ArithError::DIVISION_BY_ZERO);
+
+        // Alias : out is one of the operands, big value shared by copies
+        Integer x = big, y = x;
+        CHECK(Integer::add(x, x, x) == ArithError::NONE);
+        CHECK_EQ(x.toString(), std::string("246913578024691357802469135780"));
+        CHECK_EQ(y.toString(), big.toString());
+        CHECK(Integer::mul(y, y, y) == ArithError::NONE);
+        CHECK(Integer::div(y, big, y) == ArithError::NONE);
+        CHECK_EQ(y.toString(), big.toString());
+    }
+
+    // C. Bound of one value : hostile powers stop with TOO_LARGE
+    {
+        Integer out;
+        CHECK(Integer::pow(Integer(2), Integer((long long)Integer::MAX_BITS + 8), out) == ArithError::TOO_LARGE);
+        CHECK(Integer::pow(Integer(2), Integer((long long)Integer::MAX_BITS - 8), out) == ArithError::NONE);
+        CHECK(Integer::mul(out, out, out) == ArithError::TOO_LARGE);
+        CHECK(Integer::fromLiteral(std::string(400000, '9'), out) == ArithError::TOO_LARGE);
+    }
+
+    // D. Interpreter : exact values agree with the wrap around ones modulo 2^64
+    std::mt19937 program(41);
+    size_t big = 0;
+    for (int round = 0; round < 300; ++round)
+    {
+        std::string source = "a = 3;\nb = -5;\nc = 9223372036854775807;\nd = 11;\ne = -13;\nf = 17;\n";
+        for (int i = 0; i < 10; ++i)
+            source += std::string(1, (char)('a' + program() % 6)) + " = " + ringExpression(program, 4) + ";\n";
+        Program wrapping(source), exact(source);
+        exact.setExact(true);
+        CHECK(wrapping.compile());
+        CHECK(exact.compile());
+        Evaluator narrow;
+        ExactEvaluator wide;
+        CHECK(narrow.run(wrapping.statements()));
+        CHECK(wide.run(exact.statements()));
+        for (size_t slot = 0; slot < 6; ++slot)
+        {
+            CHECK_EQ(wrapped(wide.get(slot).toString()), narrow.get(slot));
+            big += !wide.get(slot).isSmall();
+        }
+    }
+    CHECK(big > 100);
+    return compy_test::finish("test_integer");
+}
@@ -0,0 +1,45 @@
+// Lexer::tokenizeParallel must give the Token list, lexical errors and symbol ids of Lexer::tokenize
+#include "check.hpp"
+#include "../include/lexer.hpp"
+#include <random>
+
+static void compare(const std::string &text, bool extended, unsigned threads)
+{
+    SymbolTable serialNames, parallelNames;
+    Lexer serial(text), parallel(text);
+    serial.setSymbolTable(extended ? &serialNames : nullptr);
+    parallel.setSymbolTable(extended ? &parallelNames : nullptr);
+    const std::vector<Token> a = serial.tokenize();
+    const std::vector<Token> b = parallel.tokenizeParallel(threads);
+
+    CHECK_EQ(a.size(), b.size());
+    CHECK(serial.getLexicalErrors() == parallel.getLexicalErrors());
+    size_t mismatches = 0;
+    for (size_t i = 0; i < a.size() && i < b.size(); ++i)
+        mismatches += !(a[i].type == b[i].type && a[i].value == b[i].value && a[i].start_pos == b[i].start_pos && a[i].symbol == b[i].symbol);
+    CHECK_EQ(mismatches, (size_t)0);
+}
+
+int main()
+{
+    // Random Token soup over several lines (Long names, long numbers, invalid bytes, UTF-8) : 1 MB, every cut land somewhere odd
+    static const char *pieces[] = {"a", "rate_2", "total", "123", "98765432109876543210", "+", "-", "*", "/", "%", "^", "=",
+                                   "(", ")", ";", "$", "\xC3\xA9", "\n", "  ", "\t"};
+    for (uint32_t seed = 1; seed <= 4; ++seed)
+    {
+        std::mt19937 rng(seed);
+        std::string text;
+        while (text.size() < (1u << 20))
+        {
+            text += pieces[rng() % (sizeof(pieces) / sizeof(pieces[0]))];
+            if (rng() % 3)
+                text += ' ';
+        }
+        for (unsigned threads : {2u, 3u, 8u})
+        {
+            compare(text, false, threads);
+            compare(text, true, threads);
+        }
+    }
+    return compy_test::finish("test_lexer_parallel");
+}
@@ -0,0 +1,81 @@
+// ResourceLimits through Program and Lexer : Token budget is per statement (Whole program lexed at once),
+// serial and parallel lexing agree, and the tree drawing cap only apply when limits are set
+#include "check.hpp"
+#include "../include/lexer.hpp"
+#include "../include/program.hpp"
+#include <sstream>
+
+static std::string chain(size_t terms)
+{
+    std::string text = "x = a";
+    for (size_t i = 1; i < terms; ++i)
+        text += " + a";
+    return text + ";\n";
+}
+
+static std::string drawn(const std::string &text, const ResourceLimits *limits)
+{
+    Lexer lexer(text);
+    const std::vector<Token> tokens = lexer.tokenize();
+    Parser parser(tokens);
+    parser.setLimits(limits);
+    parser.parse();
+    std::ostringstream out;
+    std::streambuf *old = std::cout.rdbuf(out.rdbuf());
+    parser.displayTree();
+    std::cout.rdbuf(old);
+    return out.str();
+}
+
+int main()
+{
+    ResourceLimits limits = ResourceLimits::untrusted();
+    limits.maxTokens = 1000;
+
+    // A. Many small statements : more Token in total than the budget, every statement under it
+    {
+        std::string text;
+        for (int i = 0; i < 500; ++i)
+            text += "x = x + " + std::to_string(i) + ";\n";
+        Program program(text);
+        program.setLimits(limits);
+        CHECK(program.compile());
+        CHECK_EQ(program.size(), (size_t)500);
+    }
+
+    // B. One statement over the budget : stopped by the Lexer, one LimitError only
+    {
+        Program program("a = 1;\n" + chain(600) + "b = 2;\n");
+        program.setLimits(limits);
+        CHECK(!program.compile());
+        CHECK(program.getErrors() == std::vector<std::string>{"LimitError: statement has more than 1000 tokens."});
+        CHECK_EQ(program.size(), (size_t)0);
+    }
+
+    // C. Parallel lexing (4 chunks of 64 KiB or more) : same verdict as serial, the long statement sit across the middle cut
+    for (size_t terms : {400, 499, 501, 3000})
+    {
+        std::string text;
+        for (int i = 0; i < 12000; ++i)
+            text += "y = y + 1;\n";
+        text += chain(terms);
+        for (int i = 0; i < 12000; ++i)
+            text += "z = z + 1;\n";
+        Lexer serial(text), parallel(text);
+        serial.setLimits(&limits);
+        parallel.setLimits(&limits);
+        limits.start();
+        const size_t serialCount = serial.tokenize().size();
+        const size_t parallelCount = parallel.tokenizeParallel(4).size();
+        CHECK_EQ(serial.limitExceeded(), (terms * 2 + 1 > 1000));  // Token before the ";"
+        CHECK_EQ(parallel.limitExceeded(), serial.limitExceeded());
+        CHECK_EQ(parallelCount, serialCount);
+    }
+
+    // D. Tree drawing : tall tree drawn without limits, refused with them
+    const std::string tall = chain(12);
+    CHECK(drawn(tall, nullptr).find("too tall") == std::string::npos);
+    CHECK(drawn(tall, nullptr).find('+') != std::string::npos);
+    CHECK(drawn(tall, &limits).find("<tree too tall to draw : height 13, limit 9>") != std::string::npos);
+    return compy_test::finish("test_limits");
+}
@@ -0,0 +1,70 @@
+// Parser : unary '-' runs and '^' chains are read without one recursion per operator (Same tree and diagnostics),
+// so very long ones parse, analyze and run; the depth budget still stop them at the same place
+#include "check.hpp"
+#include "../include/evaluator.hpp"
+#include "../include/exporter.hpp"
+#include "../include/lexer.hpp"
+#include "../include/program.hpp"
+#include "../include/resource_limits.hpp"
+#include <sstream>
+
+static std::string sexpr(const std::string &text, std::string *firstError = nullptr)
+{
+    Lexer lexer(text);
+    const std::vector<Token> tokens = lexer.tokenize();
+    Parser parser(tokens);
+    const bool ok = parser.parse();
+    if (firstError)
+        *firstError = parser.getErrors().empty() ? "" : parser.getErrors()[0];
+    std::ostringstream out;
+    {
+        TreeExporter exporter(out);
+        exporter.writeSExpr(ok ? parser.getRoot() : nullptr);
+    }
+    return out.str();
+}
+
+static std::string repeat(const std::string &piece, size_t times)
+{
+    std::string text;
+    for (size_t i = 0; i < times; ++i)
+        text += piece;
+    return text;
+}
+
+int main()
+{
+    // A. Shapes : '-' bind looser than '^', '^' is right associative
+    CHECK_EQ(sexpr("x = - - a ^ b ^ c;"), std::string("(= x (- (- (^ a (^ b c)))))\n"));
+    CHECK_EQ(sexpr("x = -a * -b ^ 2 ^ -c;"), std::string("(= x (* (- a) (- (^ b (^ 2 (- c))))))\n"));
+    CHECK_EQ(sexpr("x = a ^ b * c ^ d ^ e;"), std::string("(= x (* (^ a b) (^ c (^ d e))))\n"));
+
+    // B. Diagnostics inside a run / chain
+    std::string error;
+    sexpr("x = - - ;", &error);
+    CHECK_EQ(error, std::string("SyntaxError at position 6: missing operand after '-'"));
+    sexpr("x = - * - a;", &error);
+    CHECK_EQ(error, std::string("SyntaxError at position 6: missing left operand before the operator  '*'"));
+    sexpr("x = a ^ b ^ ;", &error);
+    CHECK_EQ(error, std::string("SyntaxError at position 10: missing operand after '^'"));
+
+    // C. Long runs : parsed, analyzed and run (No recursion left on the way)
+    {
+        Program program("a = 3;\nx = " + repeat("- ", 400001) + "a;\ny = " + repeat("1 ^ ", 200000) + "a;\n");
+        CHECK(program.compile());
+        Evaluator env;
+        CHECK(env.run(program.statements()));
+        CHECK_EQ(env.get(23), -3LL);
+        CHECK_EQ(env.get(24), 1LL);
+    }
+
+    // D. Depth budget : a run / chain deeper than maxDepth is refused
+    for (const std::string &text : {"x = " + repeat("- ", 3000) + "a;", "x = " + repeat("a ^ ", 3000) + "a;"})
+    {
+        Program program(text);
+        program.setLimits(ResourceLimits::untrusted());
+        CHECK(!program.compile());
+        CHECK(!program.getErrors().empty() && program.getErrors().back().find("LimitError: expression is nested deeper") == 0);
+    }
+    return compy_test::finish("test_parser");
+}
@@ -0,0 +1,172 @@
+// PersistentEnv : random fork / write / drop steps against one std::vector per version, changes() between versions,
+// forks of one base written on several threads, Evaluator on a fork, and the --variants mode
+#include "check.hpp"
+#include "../include/evaluator.hpp"
+#include "../include/program.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <thread>
+
+struct Version
+{
+    PersistentEnv env;
+    std::vector<long long> model;
+};
+
+static bool same(const Version &v)
+{
+    for (size_t slot = 0; slot < v.model.size() + 40; ++slot)
+        if (v.env.get(slot) != (slot < v.model.size() ? v.model[slot] : 0))
+            return false;
+    return true;
+}
+
+static std::map<size_t, long long> expectedChanges(const Version &v, const Version &base)
+{
+    std::map<size_t, long long> out;
+    for (size_t slot = 0; slot < std::max(v.model.size(), base.model.size()); ++slot)
+    {
+        const long long mine = slot < v.model.size() ? v.model[slot] : 0;
+        const long long theirs = slot < base.model.size() ? base.model[slot] : 0;
+        if (mine != theirs)
+            out[slot] = mine;
+    }
+    return out;
+}
+
+static std::string capture(const std::string &command)
+{
+    std::string out;
+    FILE *pipe = popen(command.c_str(), "r");
+    if (!pipe)
+        return "<popen failed>";
+    char buffer[4096];
+    while (fgets(buffer, sizeof(buffer), pipe))
+        if (std::string(buffer).rfind("Variants:", 0) != 0)    // Timing line
+            out += buffer;
+    pclose(pipe);
+    return out;
+}
+
+int main()
+{
+    const size_t nodesBefore = PersistentEnv::liveNodes();
+
+    // A. Random steps : fork a version, write (slots small and large, so the trie grow), drop a version
+    {
+        std::mt19937 rng(42);
+        std::vector<Version> versions(1);
+        for (int step = 0; step < 200000; ++step)
+        {
+            const unsigned pick = rng() % 10;
+            Version &v = versions[rng() % versions.size()];
+            if (pick < 2 && versions.size() < 64)
+                versions.push_back(Version{v.env.fork(), v.model});
+            else if (pick < 3 && versions.size() > 1)
+            {
+                std::swap(versions[rng() % versions.size()], versions.back());
+                versions.pop_back();
+            }
+            else
+            {
+                const size_t slot = (rng() % 4 == 0) ? rng() % 40000 : rng() % 64;
+                const long long value = (long long)(rng() % 1000) - 500;
+                v.env.set(slot, value);
+                if (v.model.size() <= slot)
+                    v.model.resize(slot + 1, 0);
+                v.model[slot] = value;
+            }
+            if (step % 4000 == 0)
+            {
+                for (const Version &each : versions)
+                    CHECK(same(each));
+                const Version &a = versions[rng() % versions.size()];
+                const Version &b = versions[rng() % versions.size()];
+                const auto changed = a.env.changes(b.env);
+                const std::map<size_t, long long> found(changed.begin(), changed.end());
+                CHECK(found == expectedChanges(a, b));
+            }
+        }
+    }
+    CHECK_EQ(PersistentEnv::liveNodes(), nodesBefore);
+
+    // B. Fork is O(1) and shares everything : no node until a write, one path of nodes after it
+    {
+        PersistentEnv base;
+        for (size_t slot = 0; slot < 10000; ++slot)
+            base.set(slot, (long long)slot);
+        const size_t baseNodes = PersistentEnv::liveNodes();
+        PersistentEnv variant = base.fork();
+        CHECK_EQ(PersistentEnv::liveNodes(), baseNodes);
+        variant.set(5000, -1);
+        const size_t pathNodes = PersistentEnv::liveNodes() - baseNodes;
+        CHECK(pathNodes >= 1 && pathNodes <= 4);
+        variant.set(5001, -2);                                  // Same leaf, now owned : updated in place
+        CHECK_EQ(PersistentEnv::liveNodes(), baseNodes + pathNodes);
+        CHECK_EQ(base.get(5000), 5000LL);
+        CHECK_EQ(variant.get(5000), -1LL);
+        CHECK_EQ(variant.changes(base).size(), (size_t)2);
+    }
+
+    // C. Forks of one base on several threads (Counts are atomic), each checked against its own model
+    {
+        PersistentEnv base;
+        for (size_t slot = 0; slot < 3000; ++slot)
+            base.set(slot, (long long)slot * 3);
+        std::vector<std::thread> workers;
+        std::vector<int> bad(8, 0);
+        for (int t = 0; t < 8; ++t)
+            workers.emplace_back([&base, &bad, t] {
+                std::mt19937 rng(t);
+                for (int round = 0; round < 500; ++round)
+                {
+                    PersistentEnv mine = base.fork();
+                    const size_t slot = rng() % 3000;
+                    mine.set(slot, -1);
+                    if (mine.get(slot) != -1 || base.get(slot) != (long long)slot * 3 || mine.changes(base).size() != 1)
+                        ++bad[t];
+                }
+            });
+        for (std::thread &worker : workers)
+            worker.join();
+        for (int count : bad)
+            CHECK_EQ(count, 0);
+    }
+    CHECK_EQ(PersistentEnv::liveNodes(), nodesBefore);
+
+    // D. Evaluator writing a fork : base untouched
+    {
+        Program base("a = 4;\nb = 9;"), variant("c = a * b;\na = a - 1;");
+        CHECK(base.compile() && variant.compile());
+        PersistentEnv shared;
+        Evaluator setup;
+        setup.setEnvironment(&shared);
+        CHECK(setup.run(base.statements()));
+        PersistentEnv fork = shared.fork();
+        Evaluator env;
+        env.setEnvironment(&fork);
+        CHECK(env.run(variant.statements()));
+        CHECK_EQ(fork.get(2), 36LL);
+        CHECK_EQ(fork.get(0), 3LL);
+        CHECK_EQ(shared.get(0), 4LL);
+        CHECK_EQ(shared.get(2), 0LL);
+    }
+
+    // E. Command line : each variant print only what it changed
+    const char *mainPath = std::getenv("COMPY_MAIN");
+    if (mainPath)
+    {
+        const std::filesystem::path file = std::filesystem::temp_directory_path() / "compy-test-variants.txt";
+        std::ofstream(file) << "a = 1;\nb = 2;\n---\na = a + 10;\n---\nc = b * 3;\nb = 0;\n";
+        CHECK_EQ(capture(std::string(mainPath) + " --variants 2 < " + file.string() + " 2>&1"),
+                 std::string("a = 1\nb = 2\nVariant 1: a = 11\nVariant 2: b = 0, c = 6\n"));
+        std::filesystem::remove(file);
+    }
+    else
+        std::cout << "test_persistent_env: COMPY_MAIN not set, command line part skipped" << std::endl;
+    return compy_test::finish("test_persistent_env");
+}
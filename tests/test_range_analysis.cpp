@@ -0,0 +1,79 @@
+// RangeAnalysis : definite division by zero (v - v included), proven checks never change a result,
+// 200k-term chains analyzed and run without recursion (with and without reassociation, 64-bit and exact)
+#include "check.hpp"
+#include "random_program.hpp"
+#include "../include/exact_evaluator.hpp"
+#include "../include/program.hpp"
+
+static std::string chain(size_t terms, const char *op)
+{
+    std::string text = "a = 1;\nx = a";
+    for (size_t i = 1; i < terms; ++i)
+        text += std::string(" ") + op + " a";
+    return text + ";\n";
+}
+
+int main()
+{
+    // A. Divisor always 0 : reported at compile time, wherever the 0 come from
+    for (const char *source : {"x = a / (b - b);", "b = 3;\nx = 5 % (b - b);", "x = a / (0 * b);", "x = -(c - c) / 1 + 7 / (2 - 2);"})
+    {
+        Program program(source);
+        CHECK(!program.compile());
+        CHECK(program.getErrors().size() == 1 && program.getErrors()[0].find("divisor is always 0") != std::string::npos);
+    }
+    {
+        Program program("b = 3;\nx = a / (b - c);");       // Different variables : only checked at run time
+        CHECK(program.compile());
+        CHECK_EQ(program.analysis().checkCount(), (size_t)2);
+        CHECK_EQ(program.analysis().provenCount(), (size_t)0);
+    }
+
+    // B. Proven operations run unchecked : same variables / same error as with every check kept (Exact mode skip the analysis)
+    size_t analyzed = 0;
+    for (uint32_t seed = 1; seed <= 300; ++seed)
+    {
+        const std::string source = RandomProgram(seed).program(20);
+        Program checked(source), unchecked(source);
+        unchecked.setExact(true);
+        if (!checked.compile())
+            continue;
+        CHECK(unchecked.compile());
+        ++analyzed;
+        Evaluator fast, slow;
+        CHECK_EQ(fast.run(checked.statements()), slow.run(unchecked.statements()));
+        CHECK(fast.getErrors() == slow.getErrors());
+        for (size_t slot = 0; slot < Evaluator::VARIABLE_COUNT; ++slot)
+            CHECK_EQ(fast.get(slot), slow.get(slot));
+    }
+    CHECK(analyzed > 100);
+
+    // C. Long chains : analysis, evaluation and exact evaluation use explicit stacks
+    for (const char *op : {"+", "-", "*"})
+    {
+        for (bool balance : {false, true})
+        {
+            Program program(chain(200000, op));
+            program.setBalance(balance);
+            CHECK(program.compile());
+            Evaluator env;
+            CHECK(env.run(program.statements()));
+            CHECK_EQ(env.get(23), op[0] == '+' ? 200000LL : op[0] == '-' ? -199998LL : 1LL);
+        }
+    }
+    {
+        Program program(chain(200000, "+"));
+        program.setExact(true);
+        CHECK(program.compile());
+        ExactEvaluator env;
+        CHECK(env.run(program.statements()));
+        CHECK_EQ(env.get(23).toString(), std::string("200000"));
+    }
+    {
+        Program program(chain(200000, "+"));
+        CHECK(program.compile());
+        CHECK_EQ(program.analysis().checkCount(), (size_t)199999);
+        CHECK_EQ(program.analysis().provenCount(), (size_t)199999);
+    }
+    return compy_test::finish("test_range_analysis");
+}
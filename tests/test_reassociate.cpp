@@ -0,0 +1,111 @@
+// Reassociate : same values and errors as the left-deep trees (64-bit and exact), logarithmic height, '-' signs
+// carried through the rebuilt chain, barriers left alone, diagnostics produced before the pass
+#include "check.hpp"
+#include "random_program.hpp"
+#include "../include/exact_evaluator.hpp"
+#include "../include/program.hpp"
+#include <random>
+
+// Chain of "terms" operands over a ... f with random + / - (or '*' only)
+static std::string chain(std::mt19937 &rng, size_t terms, bool product)
+{
+    std::string text = "x = a";
+    for (size_t i = 1; i < terms; ++i)
+    {
+        text += product ? " * " : (rng() & 1) ? " - " : " + ";
+        text += (char)('a' + rng() % 6);
+    }
+    return "a = 3;\nb = -7;\nc = 11;\nd = 2;\ne = -1;\nf = 5;\n" + text + ";\n";
+}
+
+static bool sameRun(const std::string &source)
+{
+    Program plain(source), balanced(source);
+    balanced.setBalance(true);
+    const bool compiled = plain.compile();
+    CHECK_EQ(balanced.compile(), compiled);
+    CHECK(balanced.getErrors() == plain.getErrors());
+    if (!compiled)
+        return false;
+    Evaluator left, tree;
+    CHECK_EQ(tree.run(balanced.statements()), left.run(plain.statements()));
+    CHECK(tree.getErrors() == left.getErrors());
+    for (size_t slot = 0; slot < Evaluator::VARIABLE_COUNT; ++slot)
+        CHECK_EQ(tree.get(slot), left.get(slot));
+    return true;
+}
+
+static bool sameExactRun(const std::string &source)
+{
+    Program plain(source), balanced(source);
+    plain.setExact(true);
+    balanced.setExact(true);
+    balanced.setBalance(true);
+    if (!plain.compile())
+        return false;
+    CHECK(balanced.compile());
+    ExactEvaluator left, tree;
+    CHECK_EQ(tree.run(balanced.statements()), left.run(plain.statements()));
+    for (size_t slot = 0; slot < Evaluator::VARIABLE_COUNT; ++slot)
+        CHECK_EQ(tree.get(slot).toString(), left.get(slot).toString());
+    return true;
+}
+
+int main()
+{
+    // A. Random programs (Every operator, runtime errors included) : same values, same first error
+    size_t compared = 0;
+    for (uint32_t seed = 1; seed <= 300; ++seed)
+    {
+        const std::string source = RandomProgram(seed).program(20);
+        compared += sameRun(source);
+        sameExactRun(source);
+    }
+    CHECK(compared > 100);
+
+    // B. Long chains : height logarithmic, values unchanged
+    std::mt19937 rng(43);
+    for (size_t terms : {4, 5, 7, 8, 33, 1000, 65536})
+    {
+        for (bool product : {false, true})
+        {
+            const std::string source = chain(rng, terms, product);
+            CHECK(sameRun(source));
+            CHECK(sameExactRun(source));
+            Program balanced(source);
+            balanced.setBalance(true);
+            CHECK(balanced.compile());
+            size_t log2 = 0;
+            while (((size_t)1 << log2) < terms)
+                ++log2;
+            CHECK_EQ(balanced.reassociation().chainCount(), (size_t)1);
+            CHECK_EQ(balanced.reassociation().heightBefore(), terms + 1);       // '=' Node + left-deep chain
+            CHECK_EQ(balanced.reassociation().heightAfter(), log2 + 2);
+        }
+    }
+
+    // C. Signs : right operand of '-' flip everything under it, mixed with barriers and unary minus
+    for (const char *source : {"a = 5;\nb = 3;\nc = 2;\nd = 9;\nx = a - (b - c) - d + (a - (b + c - d)) - -b;",
+                               "a = 5;\nb = 3;\nc = 2;\nx = a - b * c * a * b - c / b - a % c + (a ^ c) - b;",
+                               "a = 9223372036854775807;\nb = 3;\nx = a + a + a - b * a * a * b * a - a;"})
+    {
+        CHECK(sameRun(source));
+        CHECK(sameExactRun(source));
+    }
+
+    // D. Barriers and short chains are not rebuilt; diagnostics come from the tree as written
+    {
+        Program program("a = 2;\nx = a / a / a / a / a;\ny = a ^ a ^ a ^ a;\nz = a + a + a;");
+        program.setBalance(true);
+        CHECK(program.compile());
+        CHECK_EQ(program.reassociation().chainCount(), (size_t)0);
+    }
+    {
+        CHECK(!sameRun("b = 1;\nx = a + b + c + d / (b - b) + e;"));
+        Program program("x = a + b + c + d / (b - b) + e;");
+        program.setBalance(true);
+        CHECK(!program.compile());
+        CHECK(program.getErrors()[0].find("column 19") != std::string::npos);
+    }
+    return compy_test::finish("test_reassociate");
+}
@@ -0,0 +1,74 @@
+// Recognizer vs Lexer + Parser : same verdict and same first diagnostic (Lexical error first, else first syntax error)
+// on random statements, on the same statements with characters dropped / inserted / replaced, and in extended-name mode
+#include "check.hpp"
+#include "random_program.hpp"
+#include "../include/lexer.hpp"
+#include "../include/parser.hpp"
+#include "../include/recognizer.hpp"
+#include "../include/symbol_table.hpp"
+
+// First line main would print for this statement ("" when valid)
+static std::string reference(const std::string &text, SymbolTable *symbols)
+{
+    Lexer lexer(text);
+    lexer.setSymbolTable(symbols);
+    const std::vector<Token> tokens = lexer.tokenize();
+    Parser parser(tokens);
+    parser.setSourceIndex(&lexer.getSourceIndex());
+    const bool parsed = parser.parse();
+    if (lexer.hasLexicalErrors())
+        return lexer.getLexicalErrors()[0];
+    if (!parsed)
+        return parser.getErrors().empty() ? "<no message>" : parser.getErrors()[0];
+    return "";
+}
+
+static size_t mismatches = 0;
+
+static void compare(const std::string &text, SymbolTable *symbols)
+{
+    const std::string expected = reference(text, symbols);
+    const Recognizer::Result result = Recognizer::check(text, symbols != nullptr);
+    const std::string actual = Recognizer::message(text, result);
+    CHECK_EQ(result.valid, expected.empty());
+    CHECK_EQ(actual, expected);
+    if (actual != expected && ++mismatches <= 5)
+        std::cerr << "  input    : " << text << "\n  recognizer: " << actual << "\n  parser    : " << expected << std::endl;
+}
+
+int main()
+{
+    // A. Hand-picked : one input per diagnostic
+    const char *fixed[] = {"", "   ", "x = a + 1;", "1 = a;", "x a;", "x;", "x == a;", "x = ;", "x = * a;", "x = a = b;", "x = a +",
+                           "x = ();", "x = a + ;", "x = a b;", "x = (a + b;", "x = a + b", "x = a / 0;", "x = a; y = b;",
+                           "x = a $ b;", "Ab = 1;", "x = a)b;", "x = -(-a) ^ -2 % 3;", "x = 007 / 00;", "x =\n  a +\n  ;"};
+    for (const char *text : fixed)
+        compare(text, nullptr);
+
+    // B. Random statements + mutations (Alphabet hold every Token kind and a few invalid characters)
+    static const char alphabet[] = "abxyz019+-*/%^=();  $#AZ\n\t";
+    SymbolTable symbols;
+    size_t invalid = 0;
+    for (uint32_t seed = 1; seed <= 20000; ++seed)
+    {
+        RandomProgram random(seed);
+        std::string text = random.statement(3);
+        const unsigned edits = seed % 4;
+        for (unsigned e = 0; e < edits && !text.empty(); ++e)
+        {
+            const size_t at = random.next((unsigned)text.size());
+            const char c = alphabet[random.next(sizeof(alphabet) - 1)];
+            switch (random.next(3))
+            {
+            case 0: text.erase(at, 1); break;
+            case 1: text.insert(at, 1, c); break;
+            default: text[at] = c; break;
+            }
+        }
+        compare(text, nullptr);
+        compare(text, &symbols);    // Extended names : "xy", "Ab" become identifiers
+        invalid += Recognizer::check(text).valid ? 0 : 1;
+    }
+    CHECK(invalid > 5000);          // Mutations reach the error paths
+    return compy_test::finish("test_recognizer");
+}
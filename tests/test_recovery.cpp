@@ -0,0 +1,82 @@
+// Panic-mode recovery : fixed diagnostics on error-dense statements, diagnostics bounded by the input,
+// parse time linear in token count however many errors the input holds
+#include "check.hpp"
+#include "../include/lexer.hpp"
+#include "../include/parser.hpp"
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+static std::vector<std::string> diagnose(const std::string &text)
+{
+    Lexer lexer(text);
+    std::vector<Token> tokens = lexer.tokenize();
+    Parser parser(tokens);
+    parser.setSourceIndex(&lexer.getSourceIndex());
+    parser.parse();
+    return parser.getErrors();
+}
+
+// Best of 3 parse times (ms) + diagnostics of one token list
+static double parseMs(const std::vector<Token> &tokens, size_t &diagnostics)
+{
+    double best = 0.0;
+    for (int i = 0; i < 3; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        Parser parser(tokens);
+        parser.parse();
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        diagnostics = parser.getErrors().size();
+        best = i ? std::min(best, ms) : ms;
+    }
+    return best;
+}
+
+static std::string soup(size_t pieces, uint32_t seed, const std::vector<std::string> &alphabet)
+{
+    std::mt19937 rng(seed);
+    std::string text = "x = ";
+    for (size_t i = 0; i < pieces; ++i)
+        text += alphabet[rng() % alphabet.size()] + " ";
+    return text + ";";
+}
+
+int main()
+{
+    // A. One diagnostic per error region, no cascade
+    typedef std::vector<std::string> Lines;
+    CHECK(diagnose("x = + * a b ;") == (Lines{
+        "SyntaxError at line 1, column 5: missing left operand before the operator  '+'",
+        "SyntaxError at line 1, column 11: missing operator before 'b'"}));
+    CHECK(diagnose("x = (a + ) ) b;") == (Lines{
+        "SyntaxError at line 1, column 8: missing operand after '+'",
+        "SyntaxError at line 1, column 12: missing statement terminator ';'."}));
+    CHECK(diagnose("x = + * / ^ = + * / ^ = + * / ^ = ;").size() == 1);
+    CHECK(diagnose("= ; x = ; y").size() == 6);
+
+    // B. Adversarial inputs : diagnostics bounded, time per token flat from n to 8n tokens
+    const std::vector<Lines> alphabets = {
+        {"+", "*", "/", "^", "="},                                             // Operators only
+        {"a", "b", "1", "2"},                                                  // Missing operators
+        {"(", "a", ")", ")", "+"},                                             // Unbalanced parentheses
+        {"a", "7", "+", "-", "*", "/", "%", "^", "=", "(", ")", ";", "$", "b"}, // Everything
+    };
+    for (size_t k = 0; k < alphabets.size(); ++k)
+    {
+        double perToken[2] = {0.0, 0.0};
+        const size_t sizes[2] = {100000, 800000};
+        for (int s = 0; s < 2; ++s)
+        {
+            Lexer lexer(soup(sizes[s], (uint32_t)k + 1, alphabets[k]));
+            const std::vector<Token> tokens = lexer.tokenize();
+            size_t diagnostics = 0;
+            perToken[s] = parseMs(tokens, diagnostics) / (double)tokens.size();
+            CHECK(diagnostics <= tokens.size() / 3 + 2);
+        }
+        // Linear = flat time per token (x4 margin for cache and machine noise; quadratic would be x8)
+        CHECK(perToken[1] < perToken[0] * 4.0 + 1e-6);
+    }
+
+    return compy_test::finish("test_recovery");
+}
@@ -0,0 +1,198 @@
+// ShmRing : several producers on one region each get back exactly their own verdicts, a producer keep at most one
+// ring in flight, oversized statements are clamped to a slot, producer limit, and two --shm-client processes at once
+#include "check.hpp"
+#include "random_program.hpp"
+#include "../include/shm_ring.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+
+// Compiler threads as serveRing run them (Verdict published to the producer named in the request)
+static void serve(ShmRing &ring, std::atomic<bool> &done)
+{
+    ShmRing::Request request;
+    for (unsigned idle = 0; !done.load();)
+    {
+        if (!ring.acquire(request))
+        {
+            ShmRing::backoff(idle);
+            continue;
+        }
+        idle = 0;
+        ShmRing::Response response;
+        response.id = request.id;
+        response.producer = request.producer;
+        response.result = Recognizer::check(request.data, request.size);
+        while (!ring.publish(response) && !done.load())
+            std::this_thread::yield();
+        ring.release(request);
+    }
+}
+
+static std::string capture(const std::string &command)
+{
+    std::string out;
+    FILE *pipe = popen(command.c_str(), "r");
+    if (!pipe)
+        return "<popen failed>";
+    char buffer[4096];
+    while (fgets(buffer, sizeof(buffer), pipe))
+        out += buffer;
+    pclose(pipe);
+    return out;
+}
+
+int main()
+{
+    const std::string name = "compy-test-" + std::to_string(::getpid());
+
+    // A. Four producers at once : every id comes back once, to its sender, with the Recognizer verdict
+    {
+        ShmRing server;
+        CHECK(server.create(name, 64));
+        std::atomic<bool> done(false);
+        std::vector<std::thread> compilers;
+        for (int t = 0; t < 2; ++t)
+            compilers.emplace_back(serve, std::ref(server), std::ref(done));
+
+        const size_t COUNT = 5000;
+        std::vector<int> bad(4, 0);
+        std::vector<std::thread> producers;
+        for (int p = 0; p < 4; ++p)
+            producers.emplace_back([&, p] {
+                ShmRing ring;
+                if (!ring.open(name))
+                {
+                    ++bad[p];
+                    return;
+                }
+                RandomProgram random(44 + p);
+                std::vector<std::string> text(COUNT);
+                std::vector<int> seen(COUNT, 0);
+                for (size_t i = 0; i < COUNT; ++i)
+                    text[i] = (i % 7 == 3) ? random.statement(2).substr(2) : random.statement(2);   // Some without "x ="
+                size_t sent = 0, received = 0;
+                ShmRing::Response response;
+                for (unsigned idle = 0; received < COUNT;)
+                {
+                    bool progress = false;
+                    if (sent < COUNT && ring.submit(sent, text[sent].data(), text[sent].size()))
+                    {
+                        ++sent;
+                        progress = true;
+                    }
+                    while (ring.collect(response))
+                    {
+                        progress = true;
+                        ++received;
+                        if (response.id >= COUNT || seen[response.id]++ ||
+                            response.result.valid != Recognizer::check(text[response.id]).valid ||
+                            response.result.position != Recognizer::check(text[response.id]).position)
+                            ++bad[p];
+                    }
+                    if (progress)
+                        idle = 0;
+                    else
+                        ShmRing::backoff(idle);
+                }
+            });
+        for (std::thread &producer : producers)
+            producer.join();
+        done = true;
+        for (std::thread &compiler : compilers)
+            compiler.join();
+        for (int count : bad)
+            CHECK_EQ(count, 0);
+        ShmRing::unlink(name);
+    }
+
+    // B. One ring in flight per producer, size clamped to a slot, at most MAX_PRODUCERS producers attached
+    {
+        ShmRing server;
+        CHECK(server.create(name, 4));
+        ShmRing producer;
+        CHECK(producer.open(name));
+        const std::string longText(ShmRing::SLOT_BYTES + 40, 'a');
+        for (uint64_t id = 0; id < 4; ++id)
+            CHECK(producer.submit(id, longText.data(), longText.size()));
+        CHECK(!producer.submit(4, "a = 1;", 6));                // Request ring full
+
+        ShmRing::Request request;
+        for (int i = 0; i < 4; ++i)
+        {
+            CHECK(server.acquire(request));
+            CHECK_EQ(request.size, ShmRing::SLOT_BYTES);
+            ShmRing::Response response;
+            response.id = request.id;
+            response.producer = request.producer;
+            CHECK(server.publish(response));
+            server.release(request);
+        }
+        CHECK(!producer.submit(4, "a = 1;", 6));                // Request ring free, but 4 verdicts not collected yet
+        ShmRing::Response response;
+        CHECK(producer.collect(response));
+        CHECK_EQ(response.id, (uint64_t)0);
+        CHECK(producer.submit(4, "a = 1;", 6));
+
+        ShmRing::Response stray;                                // Unknown producer : dropped, nothing delivered
+        stray.producer = ShmRing::MAX_PRODUCERS + 3;
+        CHECK(server.publish(stray));
+
+        std::vector<std::unique_ptr<ShmRing>> more;
+        for (uint32_t p = 1; p < ShmRing::MAX_PRODUCERS; ++p)
+        {
+            more.emplace_back(new ShmRing());
+            CHECK(more.back()->open(name));
+        }
+        ShmRing extra;
+        CHECK(!extra.open(name));
+        CHECK(extra.getError().find("producers") != std::string::npos);
+        more.pop_back();                                        // Nothing in flight : its ring is free again
+        ShmRing late;
+        CHECK(late.open(name));
+        ShmRing::unlink(name);
+    }
+
+    // C. Command line : two clients on one server print the same as --check
+    const char *mainPath = std::getenv("COMPY_MAIN");
+    if (mainPath)
+    {
+        const std::filesystem::path dir = std::filesystem::temp_directory_path() / name;
+        std::filesystem::create_directories(dir);
+        RandomProgram random(44);
+        std::ofstream input(dir / "in.txt");
+        for (int i = 0; i < 4000; ++i)
+            input << ((i % 9 == 4) ? random.statement(3) + " )" : random.statement(3)) << "\n";
+        input.close();
+        const std::string in = (dir / "in.txt").string(), ring = name + "-cli";
+        const std::string expected = capture(std::string(mainPath) + " --check < " + in);
+
+        std::thread server([&] { std::system((std::string(mainPath) + " --shm " + ring + " 2 2> /dev/null").c_str()); });
+        bool ready = false;
+        for (int attempt = 0; attempt < 250 && !ready; ++attempt)    // Until the server has created the region
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            ShmRing probe;
+            ready = probe.open(ring);
+        }
+        CHECK(ready);
+        std::string second;
+        std::thread other([&] { second = capture(std::string(mainPath) + " --shm-client " + ring + " < " + in + " 2>&1"); });
+        const std::string first = capture(std::string(mainPath) + " --shm-client " + ring + " < " + in + " 2>&1");
+        other.join();
+        CHECK_EQ(first, expected);
+        CHECK_EQ(second, expected);
+        capture("echo exit | " + std::string(mainPath) + " --shm-client " + ring);
+        server.join();
+        std::filesystem::remove_all(dir);
+    }
+    else
+        std::cout << "test_shm_ring: COMPY_MAIN not set, command line part skipped" << std::endl;
+    return compy_test::finish("test_shm_ring");
+}
@@ -0,0 +1,132 @@
+// utf8 helpers + SourceIndex : ASCII skipping at every alignment, decode of valid / invalid / truncated sequences,
+// line:column against a byte-by-byte reference (multi-line, multi-byte, random lookups), diagnostics of Lexer / Program
+#include "check.hpp"
+#include "../include/lexer.hpp"
+#include "../include/program.hpp"
+#include <random>
+
+// Reference : lines counted on '\n', columns counted on bytes that are not continuation bytes
+static SourceIndex::Location reference(const std::string &text, size_t offset)
+{
+    SourceIndex::Location loc{1, 1};
+    for (size_t i = 0; i < offset && i < text.size(); ++i)
+    {
+        if (text[i] == '\n')
+            loc = SourceIndex::Location{loc.line + 1, 1};
+        else if (((unsigned char)text[i] & 0xC0) != 0x80)
+            ++loc.column;
+    }
+    return loc;
+}
+
+static size_t decodeLength(const std::string &bytes, bool &valid) { return utf8::decode(bytes.data(), bytes.size(), 0, valid); }
+
+int main()
+{
+    // A. skipAscii : first byte >= 0x80 wherever it sits (Inside / across the 16-byte SIMD blocks), size when none
+    for (size_t size : {0, 1, 15, 16, 17, 31, 32, 33, 100})
+    {
+        const std::string ascii(size, 'a');
+        CHECK_EQ(utf8::skipAscii(ascii.data(), ascii.size(), 0), size);
+        for (size_t at = 0; at < size; ++at)
+        {
+            std::string text = ascii;
+            text[at] = (char)0xC3;
+            for (size_t from = 0; from <= at; from += 7)
+                CHECK_EQ(utf8::skipAscii(text.data(), text.size(), from), at);
+            CHECK_EQ(utf8::skipAscii(text.data(), text.size(), at + 1), size);
+        }
+    }
+
+    // B. decode : length of a valid code point, maximal valid prefix (at least 1) of an invalid one
+    struct Case
+    {
+        const char *bytes;
+        size_t length;
+        bool valid;
+    };
+    const Case cases[] = {
+        {"a", 1, true},
+        {"\xC3\xA9", 2, true},              // é
+        {"\xE2\x82\xAC", 3, true},          // €
+        {"\xF0\x9F\x98\x80", 4, true},      // U+1F600
+        {"\xF4\x8F\xBF\xBF", 4, true},      // U+10FFFF
+        {"\x80", 1, false},                 // Lone continuation byte
+        {"\xC0\xAF", 1, false},             // Overlong lead byte
+        {"\xE0\x80\x80", 1, false},         // Overlong 3-byte
+        {"\xED\xA0\x80", 1, false},         // Surrogate
+        {"\xF4\x90\x80\x80", 1, false},     // Past U+10FFFF
+        {"\xF5\x80\x80\x80", 1, false},     // Invalid lead byte
+        {"\xE2\x82", 2, false},             // Truncated at end of input
+        {"\xF0\x9F\x98", 3, false},
+        {"\xE2\x82x", 2, false},            // Cut by an ASCII byte
+        {"\xC3\xC3\xA9", 1, false},         // Lead byte where a continuation is expected
+    };
+    for (const Case &c : cases)
+    {
+        bool valid = !c.valid;
+        CHECK_EQ(decodeLength(c.bytes, valid), c.length);
+        CHECK_EQ(valid, c.valid);
+    }
+
+    // C. SourceIndex : fixed text, then random text against the reference (Sequential + random lookups, end of input)
+    {
+        const std::string text = "x = 1;\n\xC3\xA9t\xC3\xA9 = 2;\n\n\xE2\x82\xAC\xF0\x9F\x98\x80 y";
+        const SourceIndex index(text.data(), text.size());
+        CHECK_EQ(index.describe(0), std::string("line 1, column 1"));
+        CHECK_EQ(index.describe(7), std::string("line 2, column 1"));
+        CHECK_EQ(index.describe(12), std::string("line 2, column 4"));      // After 2-byte, ASCII, 2-byte characters
+        CHECK_EQ(index.describe(18), std::string("line 3, column 1"));
+        CHECK_EQ(index.describe(19), std::string("line 4, column 1"));
+        CHECK_EQ(index.describe(27), std::string("line 4, column 4"));      // After a 3-byte and a 4-byte character
+        CHECK_EQ(index.describe(text.size()), std::string("line 4, column 5"));
+    }
+    std::mt19937 rng(28);
+    const char *pieces[] = {"a", " ", "\n", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\x80", "\xE2\x82", "\xFF"};
+    for (int round = 0; round < 200; ++round)
+    {
+        std::string text;
+        const size_t length = rng() % 600;
+        while (text.size() < length)
+            text += pieces[rng() % 9];
+        const SourceIndex index(text.data(), text.size());
+        for (size_t offset = 0; offset <= text.size(); offset += 1 + rng() % 5)    // In order : cached column reused
+        {
+            const SourceIndex::Location got = index.locate(offset), want = reference(text, offset);
+            CHECK(got.line == want.line && got.column == want.column);
+        }
+        for (int i = 0; i < 50; ++i)                                                // Any order
+        {
+            const size_t offset = rng() % (text.size() + 1);
+            const SourceIndex::Location got = index.locate(offset), want = reference(text, offset);
+            CHECK(got.line == want.line && got.column == want.column);
+        }
+    }
+
+    // D. Diagnostics : one error per invalid code point, line:column after multi-byte characters
+    {
+        Lexer lexer("x = 1;\n\xC3\xA9 = \xE2\x82 + \xFF;");
+        lexer.tokenize();
+        const std::vector<std::string> &errors = lexer.getLexicalErrors();
+        CHECK_EQ(errors.size(), (size_t)3);
+        CHECK(errors.size() == 3 && errors[0].find("line 2, column 1") != std::string::npos);
+        CHECK(errors.size() == 3 && errors[1].find("line 2, column 5") != std::string::npos);
+        CHECK(errors.size() == 3 && errors[2].find("line 2, column 9") != std::string::npos);
+    }
+    {
+        // Index belong to the Lexer local to compile : messages made inside compile, readable after it
+        Program program("x = 1;\n\xE2\x82\xAC\xE2\x82\xAC;\ny = (2;\nz = 4 / (x - x);");
+        CHECK(!program.compile());
+        const std::vector<std::string> &errors = program.getErrors();
+        CHECK(!errors.empty() && errors[0].find("line 2, column 1") != std::string::npos);
+        bool unclosed = false, divisor = false;
+        for (const std::string &err : errors)
+        {
+            unclosed |= err.find("line 3") != std::string::npos;
+            divisor |= err.find("line 4, column 7") != std::string::npos;
+        }
+        CHECK(unclosed);
+        CHECK(divisor);
+    }
+    return compy_test::finish("test_source_index");
+}
@@ -0,0 +1,138 @@
+// StateStore : snapshot + log round trip; a torn record at the end of the log is cut off, a bad record
+// with data after it is reported as corruption and the log is left untouched
+#include "check.hpp"
+#include "../include/state_store.hpp"
+#include <filesystem>
+#include <fstream>
+
+static std::string base;
+
+static void writeState(const std::vector<std::pair<size_t, long long>> &writes, SymbolTable *symbols = nullptr)
+{
+    StateStore store(base, symbols);
+    Evaluator env;
+    CHECK(store.load(env));
+    env.setJournal(&store);
+    for (const auto &w : writes)
+        env.set(w.first, w.second);
+    CHECK(store.flush());
+}
+
+static bool loadState(Evaluator &env, std::string *error = nullptr, SymbolTable *symbols = nullptr)
+{
+    StateStore store(base, symbols);
+    const bool ok = store.load(env);
+    if (error)
+        *error = store.getError();
+    return ok;
+}
+
+static void reset()
+{
+    std::filesystem::remove(base + ".snap");
+    std::filesystem::remove(base + ".log");
+}
+
+static void patchLog(size_t offset, char byte)
+{
+    std::fstream file(base + ".log", std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp((std::streamoff)offset);
+    file.put(byte);
+}
+
+static void appendLog(const std::string &bytes)
+{
+    std::ofstream(base + ".log", std::ios::binary | std::ios::app) << bytes;
+}
+
+int main()
+{
+    base = (std::filesystem::temp_directory_path() / "compy-test-state").string();
+    const std::string log = base + ".log";
+
+    // A. Log round trip, then snapshot + log on top
+    reset();
+    writeState({{0, 5}, {1, -7}, {0, 9}});
+    {
+        Evaluator env;
+        CHECK(loadState(env));
+        CHECK_EQ(env.get(0), 9LL);
+        CHECK_EQ(env.get(1), -7LL);
+        StateStore store(base);
+        Evaluator again;
+        CHECK(store.load(again));
+        CHECK(store.snapshot(again));
+    }
+    CHECK_EQ(std::filesystem::file_size(log), (uintmax_t)0);
+    writeState({{2, 11}});
+    {
+        Evaluator env;
+        CHECK(loadState(env));
+        CHECK(env.get(0) == 9 && env.get(1) == -7 && env.get(2) == 11);
+    }
+
+    // B. Torn tails : partial header, and a full-size record with a bad checksum, both ending the file
+    for (const std::string &tail : {std::string("\x01\x02\x03\x04\x05\x06\x07", 7), std::string(16, '\0')})
+    {
+        reset();
+        writeState({{0, 1}, {1, 2}, {2, 3}});
+        appendLog(tail);
+        Evaluator env;
+        CHECK(loadState(env));
+        CHECK(env.get(0) == 1 && env.get(1) == 2 && env.get(2) == 3);
+        CHECK_EQ(std::filesystem::file_size(log), (uintmax_t)48);
+        writeState({{3, 4}});           // New record follow a good one
+        Evaluator after;
+        CHECK(loadState(after));
+        CHECK_EQ(after.get(3), 4LL);
+    }
+
+    // C. Bad record in the middle : load fail, nothing truncated
+    reset();
+    writeState({{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}});
+    patchLog(16 + 9, '\x7F');           // Value byte of the second record
+    {
+        Evaluator env;
+        std::string error;
+        CHECK(!loadState(env, &error));
+        CHECK(error.find("is corrupt at byte 16") != std::string::npos);
+        CHECK(error.find("not truncated") != std::string::npos);
+        CHECK_EQ(std::filesystem::file_size(log), (uintmax_t)80);
+    }
+
+    // D. Name records (Extended identifiers) : torn name at the end is cut off, a bad name in the middle is corruption
+    reset();
+    {
+        SymbolTable symbols;
+        const uint32_t speed = symbols.intern("speed");
+        const uint32_t total = symbols.intern("total");
+        writeState({{speed, 10}, {total, 20}}, &symbols);
+    }
+    const uintmax_t full = std::filesystem::file_size(log);  // speed name + value, total name + value
+    {
+        std::filesystem::resize_file(log, full - 16 - 4);    // Cut inside the "total" name bytes
+        SymbolTable symbols;
+        Evaluator env;
+        CHECK(loadState(env, nullptr, &symbols));
+        CHECK_EQ(env.get(SymbolTable::SINGLE_LETTERS), 10LL);
+        CHECK_EQ(symbols.size(), (size_t)SymbolTable::SINGLE_LETTERS + 1);
+        CHECK_EQ(std::filesystem::file_size(log), (uintmax_t)(16 + 8 + 16));
+    }
+    reset();
+    {
+        SymbolTable symbols;
+        writeState({{symbols.intern("speed"), 10}, {symbols.intern("total"), 20}}, &symbols);
+    }
+    patchLog(16, 'S');                  // First byte of "speed"
+    {
+        SymbolTable symbols;
+        Evaluator env;
+        std::string error;
+        CHECK(!loadState(env, &error, &symbols));
+        CHECK(error.find("is corrupt at byte 0") != std::string::npos);
+        CHECK_EQ(std::filesystem::file_size(log), full);
+    }
+
+    reset();
+    return compy_test::finish("test_state_store");
+}
@@ -0,0 +1,87 @@
+// SymbolTable : lookups through the perfect hash give the same id as the probing table, for known names,
+// unknown names and names interned after the hash was built; Program build it once a source is lexed
+#include "check.hpp"
+#include "../include/program.hpp"
+#include "../include/symbol_table.hpp"
+#include <random>
+
+static std::string randomName(std::mt19937 &rng)
+{
+    static const char chars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_";
+    std::string name(1, (char)('a' + rng() % 26));
+    for (unsigned i = rng() % 12; i > 0; --i)
+        name += chars[rng() % (sizeof(chars) - 1)];
+    return name;
+}
+
+int main()
+{
+    // A. Perfect hash table vs probing table (Same interning order = same ids)
+    std::mt19937 rng(37);
+    for (size_t count : {0, 1, 10, 500, 5000})
+    {
+        SymbolTable hashed, probing;
+        std::vector<std::string> known;
+        for (size_t i = 0; i < count; ++i)
+            known.push_back(randomName(rng));
+        for (const auto &name : known)
+            probing.intern(name);
+        CHECK(hashed.usePerfectHash(known));
+        CHECK(hashed.hasPerfectHash());
+        CHECK_EQ(hashed.size(), probing.size());
+
+        for (uint32_t id = 0; id < probing.size(); ++id)
+        {
+            const std::string &name = probing.name(id);
+            CHECK_EQ(hashed.find(name.data(), name.size()), id);
+            CHECK_EQ(hashed.name(id), name);
+        }
+        for (int i = 0; i < 2000; ++i)       // Mostly unknown names (Any perfect hash index : verify must reject them)
+        {
+            const std::string name = randomName(rng) + "_x";
+            CHECK_EQ(hashed.find(name.data(), name.size()), probing.find(name.data(), name.size()));
+        }
+        for (int i = 0; i < 200; ++i)        // Interned after the build : found by probing, same id
+        {
+            const std::string name = randomName(rng) + "_new";
+            CHECK_EQ(hashed.intern(name), probing.intern(name));
+            CHECK_EQ(hashed.find(name.data(), name.size()), probing.find(name.data(), name.size()));
+        }
+    }
+
+    // B. Over the limit : no perfect hash, lookups still right
+    {
+        SymbolTable table;
+        for (size_t i = 0; i <= SymbolTable::PERFECT_HASH_LIMIT; ++i)
+            table.intern("v" + std::to_string(i));
+        CHECK(!table.usePerfectHash({}));
+        CHECK(!table.hasPerfectHash());
+        CHECK_EQ(table.find("v77", 3), (uint32_t)(SymbolTable::SINGLE_LETTERS + 77));
+    }
+
+    // C. Program : compile does not build (Caller hash once after the base), the next Program find the same ids
+    //    through the hash, names it adds through probing
+    {
+        SymbolTable symbols, reference;
+        Program base("total = price * count;\nprice = 3;\ncount = price + 4;\n", &symbols);
+        CHECK(base.compile());
+        CHECK(!symbols.hasPerfectHash());
+        CHECK(symbols.usePerfectHash({}));
+        CHECK(symbols.usePerfectHash({}));  // Nothing new : kept
+        for (const char *name : {"total", "price", "count"})
+            reference.intern(name);
+
+        Program variant("count = total - price;\nextra = count;\n", &symbols);
+        CHECK(variant.compile());
+        reference.intern("extra");
+        CHECK_EQ(symbols.size(), reference.size());
+        for (uint32_t id = 0; id < reference.size(); ++id)
+            CHECK_EQ(symbols.find(reference.name(id).data(), reference.name(id).size()), id);
+        CHECK_EQ(variant.statement(0)->left->symbol, reference.find("count", 5));
+        CHECK(symbols.hasPerfectHash());
+        CHECK(symbols.usePerfectHash({"count", "later"}));      // "later" is new : rebuilt over it
+        CHECK_EQ(symbols.find("later", 5), (uint32_t)reference.size());
+        CHECK_EQ(symbols.find("extra", 5), reference.find("extra", 5));
+    }
+    return compy_test::finish("test_symbol_table");
+}
@@ -0,0 +1,98 @@
+// Trace : worker threads record for the statement that handed them the task (and stay quiet when it is not sampled),
+// every command-line mode write the COMPY_TRACE file on the way out
+#include "check.hpp"
+#include "../include/lexer.hpp"
+#include "../include/trace.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <unistd.h>
+
+static size_t count(const std::string &text, const std::string &what)
+{
+    size_t n = 0;
+    for (size_t at = text.find(what); at != std::string::npos; at = text.find(what, at + 1))
+        ++n;
+    return n;
+}
+
+// Thread ids that recorded a span of that name
+static std::set<std::string> threadsOf(const std::string &json, const std::string &name)
+{
+    std::set<std::string> tids;
+    for (size_t at = json.find("\"name\":\"" + name + "\""); at != std::string::npos; at = json.find("\"name\":\"" + name + "\"", at + 1))
+    {
+        const size_t tid = json.find("\"tid\":", at) + 6;
+        tids.insert(json.substr(tid, json.find(',', tid) - tid));
+    }
+    return tids;
+}
+
+static std::string readFile(const std::filesystem::path &path)
+{
+    std::ifstream file(path);
+    std::ostringstream out;
+    out << file.rdbuf();
+    return out.str();
+}
+
+int main()
+{
+    // A. tokenizeParallel : chunk spans on the worker threads, numbered with the caller's statement
+    std::string source;
+    while (source.size() < 1024 * 1024)                        // 4 chunks well above the parallel threshold
+        source += "total = rate * (a + 12) - b;\n";
+    Trace::enable(2);                                           // Statements 2, 4, ... of a thread are recorded
+    Trace::beginStatement();                                    // 1 : not sampled
+    CHECK(!Trace::sampled());
+    Lexer quiet(source);
+    quiet.tokenizeParallel(4);
+    Trace::beginStatement();                                    // 2 : sampled
+    CHECK(Trace::sampled());
+    CHECK_EQ(Trace::task().statement, (uint64_t)2);
+    Lexer traced(source);
+    traced.tokenizeParallel(4);
+    Trace::disable();
+
+    std::ostringstream out;
+    Trace::writeChromeJson(out);
+    const std::string json = out.str();
+    CHECK_EQ(count(json, "\"name\":\"scanChunk\""), (size_t)4);
+    CHECK_EQ(threadsOf(json, "scanChunk").size(), (size_t)4);
+    CHECK_EQ(count(json, "\"stmt\":1}"), (size_t)0);
+    CHECK_EQ(count(json, "\"stmt\":2}"), count(json, "\"ph\":\"X\""));
+
+    // B. Command line : the trace file is written by every mode, worker threads included (Both executor workers)
+    const char *mainPath = std::getenv("COMPY_MAIN");
+    if (!mainPath)
+    {
+        std::cout << "test_trace: COMPY_MAIN not set, command line part skipped" << std::endl;
+        return compy_test::finish("test_trace");
+    }
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / ("compy-trace-" + std::to_string(::getpid()));
+    std::filesystem::create_directories(dir);
+    const std::string in = (dir / "in.txt").string(), trace = (dir / "trace.json").string();
+    struct Mode
+    {
+        const char *args;
+        const char *input;
+        const char *span;
+        size_t spans;                                           // Spans of that name expected (One per worker / variant / line)
+    };
+    const char *program = "x = 1;\ny = x + 2;\nz = 4;\nw = z * 3;\n";
+    for (const Mode &mode : {Mode{"--check", program, "recognize", 4}, Mode{"--run 2", program, "parallelWorker", 2},
+                             Mode{"--variants 2", "x = 1;\n---\ny = x;\n---\nz = 2;\n", "variant", 2},
+                             Mode{"--export sexpr", program, "parse", 4}})
+    {
+        std::ofstream(in) << mode.input;
+        std::filesystem::remove(trace);
+        std::system(("COMPY_TRACE=" + trace + " " + mainPath + " " + mode.args + " < " + in + " > /dev/null 2>&1").c_str());
+        const std::string written = readFile(trace);
+        CHECK(written.find("\"traceEvents\"") != std::string::npos);
+        CHECK_EQ(count(written, "\"name\":\"" + std::string(mode.span) + "\""), mode.spans);
+    }
+    std::filesystem::remove_all(dir);
+    return compy_test::finish("test_trace");
+}